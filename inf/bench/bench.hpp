@@ -0,0 +1,55 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_BENCH_BENCH_HPP
+#define INF_BENCH_BENCH_HPP
+
+#include <chrono>
+#include <ostream>
+#include <vector>
+
+namespace inf::bench {
+using Clock    = std::chrono::steady_clock;
+using Function = void (*)(std::ostream &out);
+
+struct Benchmark {
+    char const *name;
+    Function    run;
+};
+
+std::vector<Benchmark> &registry();
+
+struct Registration {
+    Registration(char const *name, Function run) {
+        registry().emplace_back(name, run);
+    }
+};
+
+// wall clock seconds taken by a single call to f.
+template <class F> double seconds(F &&f) {
+    auto start = Clock::now();
+    f();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+} // namespace inf::bench
+
+#define INF_BENCHMARK(NAME)                                                    \
+    static void                    inf_bench_##NAME(std::ostream &out);        \
+    static inf::bench::Registration inf_bench_registration_##NAME{             \
+        #NAME, inf_bench_##NAME};                                              \
+    static void inf_bench_##NAME(std::ostream &out)
+
+#endif // !INF_BENCH_BENCH_HPP
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "support/decimal.hpp"
+
+// literals of the given lengths, without leading zeros.
+static std::vector<std::string>
+generate(std::size_t count, std::size_t min_length, std::size_t max_length) {
+    std::mt19937             random{42};
+    std::vector<std::string> literals;
+    literals.reserve(count);
+    for (std::size_t index = 0; index < count; ++index) {
+        std::size_t length =
+            min_length + random() % (max_length - min_length + 1);
+        std::string digits(1, static_cast<char>('1' + random() % 9));
+        while (digits.size() < length) {
+            digits.push_back(static_cast<char>('0' + random() % 10));
+        }
+        literals.emplace_back(std::move(digits));
+    }
+    return literals;
+}
+
+INF_BENCHMARK(decimal) {
+    struct Corpus {
+        char const *name;
+        std::size_t min_length;
+        std::size_t max_length;
+    };
+
+    for (Corpus corpus : {Corpus{"1-4 digits", 1, 4},
+                          Corpus{"1-19 digits", 1, 19},
+                          Corpus{"16-19 digits", 16, 19},
+                          Corpus{"20-80 digits", 20, 80}}) {
+        std::vector<std::string> literals =
+            generate(1000000, corpus.min_length, corpus.max_length);
+        std::vector<inf::Integer> expected(literals.size());
+        std::vector<inf::Integer> actual(literals.size());
+
+        double gmp = inf::bench::seconds([&]() {
+            for (std::size_t index = 0; index < literals.size(); ++index) {
+                expected[index] = inf::Integer{literals[index]};
+            }
+        });
+        double simd = inf::bench::seconds([&]() {
+            for (std::size_t index = 0; index < literals.size(); ++index) {
+                actual[index] = inf::parse_integer(literals[index]);
+            }
+        });
+
+        out << corpus.name << ": gmp " << gmp << "s, parse_integer " << simd
+            << "s, " << gmp / simd << "x, "
+            << (expected == actual ? "identical" : "MISMATCH") << "\n";
+    }
+}
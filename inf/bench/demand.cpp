@@ -0,0 +1,131 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "api/jit.hpp"
+#include "bench.hpp"
+#include "core/codegen.hpp"
+#include "core/emit.hpp"
+#include "core/lower.hpp"
+#include "core/optimize.hpp"
+#include "core/parser.hpp"
+#include "core/passes.hpp"
+#include "core/reachable.hpp"
+
+// bindings of which one in ten is live: b0, b10, b20... refer to each
+// other and the entry to the last of them, while the rest refer to each
+// other alone. each refers to two before it, so the dead are not trivially
+// dead once lowered.
+static std::string generate(unsigned bindings) {
+    std::string text;
+    for (unsigned index = 0; index < bindings; ++index) {
+        text += "b" + std::to_string(index) + " = ";
+        if (index < 20) {
+            text += std::to_string(index);
+        } else {
+            text += "b" + std::to_string(index - 10) + " - b" +
+                    std::to_string(index - 20) + " + " +
+                    std::to_string(index % 7);
+        }
+        text += ";\n";
+    }
+    return text;
+}
+
+static std::string last_live(unsigned bindings) {
+    return "b" + std::to_string((bindings - 1) / 10 * 10);
+}
+
+struct Compiled {
+    double      seconds;
+    std::size_t bytes;
+};
+
+// the whole pipeline from text to objects, as main runs it.
+static Compiled compile(std::string const &text,
+                        bool               retain,
+                        bool               mir_passes,
+                        unsigned           level) {
+    std::size_t bytes   = 0;
+    double      elapsed = inf::bench::seconds([&]() {
+        inf::Context  context{"demand"};
+        inf::Location source = context.sources().add("demand", text);
+        yy::Lexer     lexer{&context};
+        lexer.set_view(context.sources().text(source), source);
+
+        std::vector<inf::Ast::Ptr> statements;
+        yy::Parser                 parser{&lexer, &context, &statements};
+        parser.parse();
+
+        if (retain) { inf::retain_reachable(context, statements); }
+        inf::mir::Module module = inf::lower(context, statements);
+        statements.clear();
+        if (mir_passes) {
+            inf::mir::optimize(module);
+        } else {
+            inf::mir::fold_constants(module);
+        }
+        inf::codegen(context, module);
+        inf::optimize(context, level);
+        for (auto &object : inf::emit_objects(context, 1)) {
+            bytes += object.size();
+        }
+    });
+    return {elapsed, bytes};
+}
+
+INF_BENCHMARK(demand) {
+    for (unsigned bindings : {1000u, 10000u, 50000u}) {
+        std::string text  = generate(bindings);
+        std::string entry = text + last_live(bindings) + " + 1;\n";
+        out << bindings << " bindings, 10% live\n";
+
+        // the MIR passes drop dead bindings too, but only once they have
+        // been lowered; without them LLVM is handed everything.
+        for (bool mir_passes : {false, true}) {
+            for (unsigned level : {0u, 2u}) {
+                Compiled all  = compile(entry, false, mir_passes, level);
+                Compiled live = compile(entry, true, mir_passes, level);
+                out << "  " << (mir_passes ? "mir" : "no mir") << " -O"
+                    << level << ": all " << all.seconds << "s, " << all.bytes
+                    << " bytes; reachable " << live.seconds << "s, "
+                    << live.bytes << " bytes\n";
+            }
+        }
+
+        // a library compiles a binding, and what it calls, on first call.
+        std::optional<inf::Library> library;
+        double                      load = inf::bench::seconds(
+            [&]() { library.emplace(inf::load(text)); });
+        std::int64_t                first = 0;
+        double                      call  = inf::bench::seconds([&]() {
+            first = library->function(last_live(bindings))();
+        });
+        std::optional<inf::Expression> eager;
+        double                         compiled = inf::bench::seconds([&]() {
+            eager.emplace(inf::compile(entry, {}));
+        });
+        out << "  lazy: load " << load << "s, first call " << call
+            << "s; eager compile " << compiled << "s"
+            << (first + 1 == eager->function<std::int64_t()>()() ? ""
+                                                                 : " MISMATCH")
+            << "\n";
+    }
+}
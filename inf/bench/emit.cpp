@@ -0,0 +1,73 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <thread>
+
+#include "llvm/IR/Function.h"
+
+#include "bench.hpp"
+#include "core/emit.hpp"
+
+// a module of many independent arithmetic functions, large enough that
+// instruction selection dominates emission time.
+static void generate(inf::Context &context,
+                     unsigned      functions,
+                     unsigned      depth) {
+    llvm::LLVMContext  &llvm_context = context.ir_context();
+    llvm::IRBuilder<>  &builder      = context.builder();
+    llvm::Type         *i64          = builder.getInt64Ty();
+    llvm::FunctionType *type =
+        llvm::FunctionType::get(i64, {i64, i64}, /* isVarArg = */ false);
+
+    for (unsigned index = 0; index < functions; ++index) {
+        llvm::Function *function =
+            llvm::Function::Create(type,
+                                   llvm::Function::ExternalLinkage,
+                                   "f" + std::to_string(index),
+                                   context.module());
+        builder.SetInsertPoint(
+            llvm::BasicBlock::Create(llvm_context, "entry", function));
+
+        llvm::Value *a = function->getArg(0);
+        llvm::Value *b = function->getArg(1);
+        for (unsigned step = 0; step < depth; ++step) {
+            llvm::Value *c = builder.CreateMul(a, builder.getInt64(step + 3));
+            a              = builder.CreateAdd(c, b);
+            b              = builder.CreateXor(b, a);
+        }
+        builder.CreateRet(builder.CreateSub(a, b));
+    }
+}
+
+INF_BENCHMARK(emit) {
+    unsigned const hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned threads = 1; threads <= hardware; threads *= 2) {
+        inf::Context context{"emit"};
+        generate(context, 4096, 64);
+
+        std::size_t bytes   = 0;
+        double      elapsed = inf::bench::seconds([&]() {
+            for (auto &object : inf::emit_objects(context, threads)) {
+                bytes += object.size();
+            }
+        });
+
+        out << "threads " << threads << ": " << elapsed << "s, " << bytes
+            << " bytes\n";
+    }
+}
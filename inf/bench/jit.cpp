@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+#include "api/jit.hpp"
+#include "bench.hpp"
+
+using Binary = std::int64_t(std::int64_t, std::int64_t);
+
+// what the expression compiles to, written by hand: overflow traps, and
+// y % 7 can neither overflow nor divide by zero.
+[[gnu::noinline]] static std::int64_t native(std::int64_t x, std::int64_t y) {
+    std::int64_t product;
+    std::int64_t sum;
+    if (__builtin_mul_overflow(x, std::int64_t{3}, &product) ||
+        __builtin_add_overflow(product, y % 7, &sum)) {
+        __builtin_trap();
+    }
+    return sum;
+}
+
+// called through a pointer, as the jit function must be.
+static double per_call(Binary *f, std::int64_t &sink) {
+    constexpr std::int64_t calls  = 100000000;
+    Binary *volatile       target = f;
+    double                 total = inf::bench::seconds([&]() {
+        std::int64_t sum = 0;
+        for (std::int64_t index = 0; index < calls; ++index) {
+            sum += target(index, index >> 3);
+        }
+        sink = sum;
+    });
+    return total / static_cast<double>(calls) * 1e9;
+}
+
+INF_BENCHMARK(jit) {
+    std::array<std::string_view, 2> parameters{"x", "y"};
+
+    std::optional<inf::Expression> expression;
+    double                         compile = inf::bench::seconds([&]() {
+        expression.emplace(inf::compile("x * 3 + y % 7", parameters));
+    });
+
+    std::int64_t jit_sum    = 0;
+    std::int64_t native_sum = 0;
+    double       jit    = per_call(expression->function<Binary>(), jit_sum);
+    double       direct = per_call(&native, native_sum);
+
+    out << "compile " << compile << "s\n"
+        << "jit:    " << jit << "ns per call\n"
+        << "native: " << direct << "ns per call\n"
+        << (jit_sum == native_sum ? "identical" : "MISMATCH") << "\n";
+}
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+#include <thread>
+
+#include "bench.hpp"
+#include "core/tokenize.hpp"
+
+// roughly size bytes of bindings and entries.
+static std::string generate(std::size_t size) {
+    std::string text;
+    text.reserve(size + 64);
+    for (unsigned index = 0; text.size() < size; ++index) {
+        std::string name = "value" + std::to_string(index);
+        text += name + " = (" + std::to_string(index) + " + 17) * 3 - " +
+                std::to_string(index % 97) + " / 4;\n" + name + " % 13;\n";
+    }
+    return text;
+}
+
+INF_BENCHMARK(lex) {
+    constexpr std::size_t size = 32 * 1024 * 1024;
+    std::string           text = generate(size);
+    double                megabytes =
+        static_cast<double>(text.size()) / (1024.0 * 1024.0);
+
+    double baseline = 0;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u, 32u}) {
+        inf::Context  context{"lex"};
+        inf::Location source = context.sources().add("lex", text);
+
+        std::size_t count   = 0;
+        double      elapsed = inf::bench::seconds([&]() {
+            count = inf::tokenize(context, source, threads).size();
+        });
+        if (threads == 1) { baseline = elapsed; }
+
+        out << threads << " threads: " << elapsed << "s, "
+            << megabytes / elapsed << " MB/s, " << count << " tokens, "
+            << baseline / elapsed << "x\n";
+    }
+    out << "(" << std::thread::hardware_concurrency()
+        << " hardware threads)\n";
+}
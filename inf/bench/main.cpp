@@ -0,0 +1,50 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <string_view>
+
+#include "bench.hpp"
+
+namespace inf::bench {
+std::vector<Benchmark> &registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+} // namespace inf::bench
+
+// usage: inf_bench [name...]
+// with no names every registered benchmark is run.
+int main(int argc, char **argv) {
+    try {
+        for (auto &benchmark : inf::bench::registry()) {
+            bool selected = argc == 1 ||
+                            std::any_of(argv + 1, argv + argc, [&](char *arg) {
+                                return std::string_view{arg} == benchmark.name;
+                            });
+            if (!selected) { continue; }
+
+            std::cout << "[" << benchmark.name << "]\n";
+            benchmark.run(std::cout);
+        }
+    } catch (std::exception const &e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#include "bench.hpp"
+#include "core/codegen.hpp"
+#include "core/lower.hpp"
+#include "core/optimize.hpp"
+#include "core/parser.hpp"
+#include "core/passes.hpp"
+
+// a chain of bindings with redundant subexpressions, a few dead bindings
+// and one entry expression at the end.
+static std::string generate(unsigned bindings) {
+    std::string text = "b0 = 7;\n";
+    for (unsigned index = 1; index < bindings; ++index) {
+        std::string previous = "b" + std::to_string(index - 1);
+        text += "b" + std::to_string(index) + " = (" + previous + " % 1000 + " +
+                previous + " % 1000) * 3 - (" + previous + " % 1000);\n";
+        if (index % 8 == 0) {
+            text += "dead" + std::to_string(index) + " = " + previous +
+                    " * " + previous + ";\n";
+        }
+    }
+    text += "b" + std::to_string(bindings - 1) + " + 1;\n";
+    return text;
+}
+
+static void run(std::ostream &out, std::string const &text, bool mir_passes) {
+    inf::Context  context{"mir"};
+    inf::Location source = context.sources().add("mir", text);
+
+    double lower_time = inf::bench::seconds([&]() {
+        yy::Lexer lexer{&context};
+        lexer.set_view(context.sources().text(source), source);
+        std::vector<inf::Ast::Ptr> statements;
+        yy::Parser                 parser{&lexer, &context, &statements};
+        parser.parse();
+
+        inf::mir::Module module = inf::lower(context, statements);
+        if (mir_passes) {
+            inf::mir::optimize(module);
+        } else {
+            inf::mir::fold_constants(module);
+        }
+        inf::codegen(context, module);
+    });
+
+    double optimize_time =
+        inf::bench::seconds([&]() { inf::optimize(context, 2); });
+
+    std::size_t instructions = 0;
+    for (llvm::Function const &function : context.module()) {
+        instructions += function.getInstructionCount();
+    }
+
+    out << (mir_passes ? "with mir:    " : "without mir: ") << "front end "
+        << lower_time << "s, llvm -O2 " << optimize_time << "s, "
+        << instructions << " instructions\n";
+}
+
+INF_BENCHMARK(mir) {
+    for (unsigned bindings : {1000u, 10000u}) {
+        std::string text = generate(bindings);
+        out << bindings << " bindings\n";
+        run(out, text, false);
+        run(out, text, true);
+    }
+}
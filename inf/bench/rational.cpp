@@ -0,0 +1,127 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#include "bench.hpp"
+#include "core/lower.hpp"
+#include "core/parser.hpp"
+#include "core/passes.hpp"
+
+// a chain of bindings mixing decimals and exact division, whose entry
+// folds to a single rational.
+static std::string generate(unsigned bindings) {
+    std::string text = "r0 = 1.5;\n";
+    for (unsigned index = 1; index < bindings; ++index) {
+        std::string previous = "r" + std::to_string(index - 1);
+        text += "r" + std::to_string(index) + " = " + previous + " * 0.75 + " +
+                std::to_string(index % 7 + 1) + " / 7 - " + previous +
+                " / 3;\n";
+    }
+    text += "r" + std::to_string(bindings - 1) + " * 2;\n";
+    return text;
+}
+
+// evaluate every function of module with rationals, as a runtime without
+// constant folding would have to on each call.
+static inf::Rational evaluate(inf::mir::Module const &module) {
+    using inf::mir::Opcode;
+
+    std::vector<inf::Rational> results;
+    results.reserve(module.functions.size());
+    std::vector<inf::Rational> values;
+    for (inf::mir::Function const &function : module.functions) {
+        values.clear();
+        for (inf::mir::Instruction const &instruction :
+             function.instructions) {
+            inf::Rational value;
+            switch (instruction.opcode) {
+            case Opcode::Constant:
+                value = module.constants[instruction.a];
+                break;
+            case Opcode::Call:   value = results[instruction.a]; break;
+            case Opcode::Negate: value = -values[instruction.a]; break;
+            case Opcode::Add:
+                value = values[instruction.a] + values[instruction.b];
+                break;
+            case Opcode::Subtract:
+                value = values[instruction.a] - values[instruction.b];
+                break;
+            case Opcode::Multiply:
+                value = values[instruction.a] * values[instruction.b];
+                break;
+            case Opcode::Divide:
+                value = values[instruction.a] / values[instruction.b];
+                break;
+            case Opcode::Modulo: {
+                inf::Rational const &a = values[instruction.a];
+                inf::Rational const &b = values[instruction.b];
+                value = a - b * inf::Rational{inf::truncate(
+                                    inf::Rational{a / b})};
+                break;
+            }
+            default: break;
+            }
+            values.emplace_back(std::move(value));
+        }
+        results.emplace_back(values[function.result]);
+    }
+    return results.back();
+}
+
+static inf::mir::Module lower(inf::Context &context, std::string const &text) {
+    inf::Location source = context.sources().add("rational", text);
+    yy::Lexer     lexer{&context};
+    lexer.set_view(context.sources().text(source), source);
+    std::vector<inf::Ast::Ptr> statements;
+    yy::Parser                 parser{&lexer, &context, &statements};
+    parser.parse();
+    return inf::lower(context, statements);
+}
+
+INF_BENCHMARK(rational) {
+    constexpr unsigned evaluations = 100;
+
+    for (unsigned bindings : {10u, 100u, 1000u}) {
+        std::string      text = generate(bindings);
+        inf::Context     context{"rational"};
+        inf::mir::Module module = lower(context, text);
+
+        inf::Rational runtime_value;
+        double        runtime = inf::bench::seconds([&]() {
+            for (unsigned count = 0; count < evaluations; ++count) {
+                runtime_value = evaluate(module);
+            }
+        });
+        runtime /= evaluations;
+
+        double fold =
+            inf::bench::seconds([&]() { inf::mir::optimize(module); });
+
+        inf::mir::Function const    &entry = module.functions.back();
+        inf::mir::Instruction const &result =
+            entry.instructions[entry.result];
+        bool folded = module.functions.size() == 1 &&
+                      result.opcode == inf::mir::Opcode::Constant &&
+                      module.constants[result.a] == runtime_value;
+
+        out << bindings << " bindings: fold " << fold
+            << "s once, runtime evaluation " << runtime << "s per call, "
+            << (folded ? "" : "NOT ") << "identical; "
+            << "folding pays off after " << fold / runtime << " calls\n";
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "bench.hpp"
+#include "core/lexer.hpp"
+
+// roughly size bytes of bindings and entries.
+static std::string generate(std::size_t size) {
+    std::string text;
+    text.reserve(size + 64);
+    for (unsigned index = 0; text.size() < size; ++index) {
+        std::string name = "value" + std::to_string(index);
+        text += name + " = (" + std::to_string(index) + " + 17) * 3 - " +
+                std::to_string(index % 97) + " / 4;\n" + name + " % 13;\n";
+    }
+    return text;
+}
+
+static std::size_t drain(yy::Lexer &lexer) {
+    std::size_t count = 1;
+    while (!lexer.advance().is<yy::Lexer::Token::End>()) {
+        ++count;
+    }
+    return count;
+}
+
+INF_BENCHMARK(stream) {
+    constexpr std::size_t size = 32 * 1024 * 1024;
+    std::string           text = generate(size);
+    double                megabytes =
+        static_cast<double>(text.size()) / (1024.0 * 1024.0);
+
+    double baseline = 0;
+    {
+        inf::Context  context{"stream"};
+        inf::Location source = context.sources().add("stream", text);
+        yy::Lexer     lexer{&context};
+        lexer.set_view(context.sources().text(source), source);
+
+        std::size_t count = 0;
+        baseline = inf::bench::seconds([&]() { count = drain(lexer); });
+        out << "in memory: " << baseline << "s, " << megabytes / baseline
+            << " MB/s, " << count << " tokens\n";
+    }
+
+    // the text arrives 4 KiB at a time, as from a pipe.
+    for (std::size_t capacity : {256u, 4096u, 64u * 1024u, 1024u * 1024u}) {
+        inf::Context  context{"stream"};
+        inf::Location source = context.sources().open("stream");
+        yy::Lexer     lexer{&context};
+
+        std::string_view rest = text;
+        lexer.set_stream(
+            [&](char *data, std::size_t size) {
+                size = std::min({size, std::size_t{4096}, rest.size()});
+                std::memcpy(data, rest.data(), size);
+                rest.remove_prefix(size);
+                return size;
+            },
+            source,
+            capacity);
+
+        std::size_t count   = 0;
+        double      elapsed = inf::bench::seconds([&]() {
+            count = drain(lexer);
+        });
+        out << capacity << " byte buffer: " << elapsed << "s, "
+            << megabytes / elapsed << " MB/s, " << count << " tokens, "
+            << baseline / elapsed << "x\n";
+    }
+}
@@ -0,0 +1,98 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "bench.hpp"
+#include "env/context.hpp"
+#include "imr/symbol.hpp"
+
+INF_BENCHMARK(symbol) {
+    for (std::size_t count : {10000u, 100000u, 1000000u}) {
+        inf::Context            context{"symbol"};
+        std::vector<inf::Label> labels;
+        labels.reserve(count);
+        for (std::size_t index = 0; index < count; ++index) {
+            labels.push_back(
+                context.intern_string("value" + std::to_string(index)));
+        }
+        std::vector<inf::Label> shuffled = labels;
+        std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937{7});
+        double millions = static_cast<double>(count) / 1e6;
+
+        inf::SymbolTable symbols;
+        double           insert = inf::bench::seconds([&]() {
+            for (std::size_t index = 0; index < count; ++index) {
+                symbols.bind(labels[index],
+                             {inf::Symbol::Kind::Binding,
+                              static_cast<std::uint32_t>(index)});
+            }
+        });
+        // as lowering does, knowing how many statements there are.
+        inf::SymbolTable reserved;
+        double           reserved_insert = inf::bench::seconds([&]() {
+            reserved.reserve(count);
+            for (std::size_t index = 0; index < count; ++index) {
+                reserved.bind(labels[index],
+                              {inf::Symbol::Kind::Binding,
+                               static_cast<std::uint32_t>(index)});
+            }
+        });
+        std::uint64_t sum    = 0;
+        double        lookup = inf::bench::seconds([&]() {
+            for (inf::Label label : shuffled) {
+                sum += symbols.find(label)->index;
+            }
+        });
+        // an entry's scope: a few parameters shadowing bindings.
+        double scopes = inf::bench::seconds([&]() {
+            for (std::size_t index = 0; index + 4 <= count; index += 4) {
+                symbols.push();
+                for (std::size_t offset = 0; offset < 4; ++offset) {
+                    symbols.bind(shuffled[index + offset],
+                                 {inf::Symbol::Kind::Parameter,
+                                  static_cast<std::uint32_t>(offset)});
+                }
+                symbols.pop();
+            }
+        });
+
+        llvm::DenseMap<char const *, std::uint32_t> map;
+        double dense_insert = inf::bench::seconds([&]() {
+            for (std::size_t index = 0; index < count; ++index) {
+                map[labels[index].data()] = static_cast<std::uint32_t>(index);
+            }
+        });
+        double dense_lookup = inf::bench::seconds([&]() {
+            for (inf::Label label : shuffled) {
+                sum += map.find(label.data())->second;
+            }
+        });
+
+        out << count << " symbols: insert " << millions / insert
+            << " M/s, reserved " << millions / reserved_insert
+            << " M/s, lookup " << millions / lookup << " M/s, scoped bind "
+            << millions / scopes << " M/s; DenseMap insert "
+            << millions / dense_insert << " M/s, lookup "
+            << millions / dense_lookup << " M/s (" << sum % 10 << ")\n";
+    }
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
+#include "api/jit.hpp"
+#include "bench.hpp"
+
+static constexpr std::string_view source =
+    "a = 10; (x * a - y) % 97 * (x + y) - a * y";
+static constexpr std::array<std::string_view, 2> parameters{"x", "y"};
+
+enum class Mode { Jit, Interpreter, Tiered };
+
+// an expression in one mode, evaluated the same way in all three.
+class Evaluator {
+    std::optional<inf::Expression> expression;
+    std::optional<inf::Tiered>     tiered;
+    inf::Expression::Packed       *packed = nullptr;
+
+  public:
+    explicit Evaluator(Mode mode) {
+        if (mode == Mode::Jit) {
+            expression.emplace(inf::compile(source, parameters));
+            packed = expression->packed();
+        } else {
+            tiered.emplace(inf::prepare(
+                source,
+                parameters,
+                {.promote_after = mode == Mode::Tiered ? 1000
+                                                       : inf::Tiered::never}));
+        }
+    }
+
+    std::int64_t operator()(std::array<std::int64_t, 2> const &arguments) {
+        return packed != nullptr ? packed(arguments.data())
+                                 : tiered->evaluate(arguments);
+    }
+
+    bool native() const { return packed != nullptr || tiered->native(); }
+};
+
+static std::int64_t run(Evaluator &evaluate, std::uint64_t evaluations) {
+    std::int64_t sum = 0;
+    for (std::uint64_t index = 0; index < evaluations; ++index) {
+        auto x = static_cast<std::int64_t>(index & 0xffff);
+        sum += evaluate({x, x >> 3});
+    }
+    return sum;
+}
+
+INF_BENCHMARK(tiered) {
+    constexpr std::array<Mode, 3> modes{
+        Mode::Jit, Mode::Interpreter, Mode::Tiered};
+    constexpr std::array<char const *, 3> names{
+        "jit", "interpreter", "tiered"};
+
+    // from source to the last of n results, so n = 1 is the time to the
+    // first result. tiered includes waiting out a compile it started but
+    // had no time to use.
+    for (std::uint64_t evaluations : {1ull, 1000ull, 100000ull, 10000000ull}) {
+        out << evaluations << " evaluations:";
+        std::array<std::int64_t, 3> sums{};
+        for (std::size_t index = 0; index < modes.size(); ++index) {
+            double elapsed = inf::bench::seconds([&]() {
+                Evaluator evaluate{modes[index]};
+                sums[index] = run(evaluate, evaluations);
+            });
+            out << " " << names[index] << " " << elapsed << "s";
+        }
+        out << (sums[0] == sums[1] && sums[1] == sums[2] ? "" : " MISMATCH")
+            << "\n";
+    }
+
+    // once warm, tiered has caught up with the jit.
+    constexpr std::uint64_t steady = 10000000;
+    for (std::size_t index = 0; index < modes.size(); ++index) {
+        Evaluator evaluate{modes[index]};
+        while (modes[index] == Mode::Tiered && !evaluate.native()) {
+            run(evaluate, 1000);
+            std::this_thread::yield();
+        }
+        std::int64_t sum     = 0;
+        double       elapsed =
+            inf::bench::seconds([&]() { sum = run(evaluate, steady); });
+        out << names[index] << ": "
+            << elapsed / static_cast<double>(steady) * 1e9
+            << "ns per evaluation (" << sum << ")\n";
+    }
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#include "bench.hpp"
+#include "core/parser.hpp"
+
+// roughly size bytes of statements, one in every period of which is broken,
+// alternating between lexical and syntax errors.
+static std::string generate(std::size_t size, unsigned period) {
+    std::string text;
+    text.reserve(size + 64);
+    for (unsigned index = 0; text.size() < size; ++index) {
+        std::string name = "value" + std::to_string(index);
+        if (period != 0 && index % period == 0) {
+            text += (index / period) % 2 == 0 ? name + " = $ 1;\n"
+                                              : name + " = 1 +;\n";
+            continue;
+        }
+        text += name + " = (" + std::to_string(index) + " + 17) * 3;\n";
+    }
+    return text;
+}
+
+INF_BENCHMARK(validate) {
+    constexpr std::size_t size = 8 * 1024 * 1024;
+
+    for (unsigned period : {0u, 1000u, 100u, 10u, 2u, 1u}) {
+        std::string text = generate(size, period);
+        double      megabytes =
+            static_cast<double>(text.size()) / (1024.0 * 1024.0);
+
+        inf::Context  context{"validate"};
+        inf::Location source = context.sources().add("validate", text);
+        yy::Lexer     lexer{&context};
+        lexer.set_view(context.sources().text(source), source);
+
+        std::vector<inf::Ast::Ptr> statements;
+        yy::Parser                 parser{&lexer, &context, &statements};
+        double elapsed = inf::bench::seconds([&]() { parser.parse(); });
+
+        if (period == 0) {
+            out << "no errors: ";
+        } else {
+            out << "1 error per " << period << " statements: ";
+        }
+        out << elapsed << "s, " << megabytes / elapsed << " MB/s, "
+            << context.errors().size() << " errors\n";
+    }
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_API_INF_H
+#define INF_API_INF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// native code for one expression, see inf::Expression.
+//
+// unless compiled with options.checked, the code executes a trap
+// instruction on overflow and division by zero, which raises SIGILL and
+// ends the process. call it directly only with arguments known to be safe,
+// and otherwise through inf_expression_evaluate.
+typedef struct inf_expression inf_expression;
+
+// see inf::JitOptions; nonzero flags are set. inf_jit_options_default
+// gives its defaults.
+typedef struct inf_jit_options {
+    unsigned    optimization_level;
+    int         round;
+    // NULL for the default.
+    char const *name;
+    int         perf;
+    int         gdb;
+    int         checked;
+} inf_jit_options;
+
+inf_jit_options inf_jit_options_default(void);
+
+// compile source into a function of the count named parameters, each an
+// int64_t. options may be NULL for the defaults. returns NULL when source
+// does not compile, and if error is not NULL stores there a message to be
+// freed by inf_error_release.
+inf_expression *inf_compile(char const            *source,
+                            char const *const     *parameters,
+                            size_t                 count,
+                            inf_jit_options const *options,
+                            char                 **error);
+
+// the function, valid until expression is released. it may be called from
+// any number of threads at once.
+void  *inf_expression_address(inf_expression const *expression);
+size_t inf_expression_arity(inf_expression const *expression);
+// nonzero when the function returns a double rather than an int64_t.
+int    inf_expression_returns_double(inf_expression const *expression);
+
+typedef enum inf_status {
+    INF_OK,
+    // the expression overflowed or divided by zero.
+    INF_FAULT,
+    // the expression was not compiled with options.checked, or returns a
+    // double.
+    INF_UNCHECKED,
+} inf_status;
+
+// evaluate an expression compiled with options.checked on arguments, one
+// per parameter, storing its value in result only when that is INF_OK.
+// like the function, it may be called from any number of threads at once.
+inf_status inf_expression_evaluate(inf_expression const *expression,
+                                   int64_t const        *arguments,
+                                   int64_t              *result);
+
+void inf_expression_release(inf_expression *expression);
+void inf_error_release(char *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !INF_API_INF_H
@@ -0,0 +1,238 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_API_JIT_HPP
+#define INF_API_JIT_HPP
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "imr/error.hpp"
+
+namespace llvm::orc {
+class LLJIT;
+class LLLazyJIT;
+} // namespace llvm::orc
+
+namespace inf {
+struct JitOptions {
+    unsigned         optimization_level = 2;
+    // allow truncating division of parameters, as --round does.
+    bool             round              = false;
+    // the file name diagnostics and profiles give the source.
+    std::string_view name               = "<expression>";
+    // announce the code to perf through a perf map and jitdump, and to gdb
+    // through its JIT interface, under names giving the statement each
+    // function came from. setting INF_JIT_PERF or INF_JIT_GDB in the
+    // environment does the same.
+    bool             perf               = false;
+    bool             gdb                = false;
+    // have compile report overflow and division by zero to the caller
+    // through Expression::checked, rather than execute a trap instruction.
+    // the trap raises SIGILL, which ends the process unless handled.
+    bool             checked            = false;
+};
+
+// native code for one expression, and the JIT which owns its memory. the
+// code is pure, so the function may be called from any number of threads
+// at once for as long as the Expression lives.
+//
+// unless compiled checked, the code traps on overflow and division by
+// zero, ending the process: only call it with arguments known to be safe.
+class Expression {
+  public:
+    using Packed  = std::int64_t(std::int64_t const *arguments);
+    // as Packed, but sets *fault to 1 and returns 0 where the unchecked
+    // function would trap, and otherwise sets it to 0.
+    using Checked = std::int64_t(std::int64_t const *arguments,
+                                 std::int32_t       *fault);
+
+  private:
+    std::unique_ptr<llvm::orc::LLJIT> m_jit;
+    void                             *m_address;
+    Packed                           *m_packed;
+    Checked                          *m_checked;
+    std::size_t                       m_arity;
+    bool                              m_returns_double;
+
+    Expression(std::unique_ptr<llvm::orc::LLJIT> jit,
+               void                             *address,
+               Packed                           *packed,
+               Checked                          *checked,
+               std::size_t                       arity,
+               bool                              returns_double) noexcept;
+
+    friend Expression compile(std::string_view                  source,
+                              std::span<std::string_view const> parameters,
+                              JitOptions                        options);
+
+  public:
+    Expression(Expression &&other) noexcept;
+    Expression &operator=(Expression &&other) noexcept;
+    ~Expression();
+
+    // when checked, a function returning an std::int64_t takes a trailing
+    // std::int32_t * as well, which it sets to 1 on a fault and otherwise
+    // leaves alone.
+    void       *address() const noexcept { return m_address; }
+    std::size_t arity() const noexcept { return m_arity; }
+    // an expression which folds to a constant that is not an integer
+    // returns a double; any other returns an std::int64_t.
+    bool        returns_double() const noexcept { return m_returns_double; }
+
+    // the function, checked against the signature it was compiled with.
+    // every parameter is an std::int64_t. throws inf::Error when it was
+    // compiled checked and returns an std::int64_t.
+    template <class F> F *function() const {
+        check(Signature<F>::arity, Signature<F>::returns_double);
+        return reinterpret_cast<F *>(m_address);
+    }
+
+    // the function taking its parameters from an array, for callers which
+    // only know its arity at runtime. throws inf::Error when it returns a
+    // double, or was compiled checked.
+    Packed  *packed() const;
+    // the same, reporting faults instead of trapping. throws inf::Error
+    // unless compiled with JitOptions::checked, or when it returns a
+    // double.
+    Checked *checked() const;
+
+  private:
+    template <class F> struct Signature;
+    template <class R, class... Args> struct Signature<R(Args...)> {
+        static_assert((std::is_same_v<Args, std::int64_t> && ...),
+                      "every parameter is an std::int64_t");
+        static_assert(std::is_same_v<R, std::int64_t> ||
+                          std::is_same_v<R, double>,
+                      "the result is an std::int64_t or a double");
+        static constexpr std::size_t arity          = sizeof...(Args);
+        static constexpr bool        returns_double = std::is_same_v<R, double>;
+    };
+
+    void check(std::size_t arity, bool returns_double) const;
+};
+
+// compile source, a sequence of bindings ending in a single expression,
+// into a function of the named parameters. the final ';' may be left off.
+// throws inf::Error listing every diagnostic when source does not compile.
+// compiles are serialized internally, so this may be called from any
+// thread.
+Expression compile(std::string_view                   source,
+                   std::span<std::string_view const> parameters,
+                   JitOptions                         options = {});
+
+struct TierOptions {
+    // jit.checked is ignored: the interpreter traps as unchecked native
+    // code does.
+    JitOptions    jit;
+    // evaluations interpreted before native code is compiled; 0 starts
+    // compiling at once, and Tiered::never never does.
+    std::uint64_t promote_after = 1000;
+};
+
+// an expression which starts out interpreted, from bytecode which takes
+// microseconds to produce where LLVM takes milliseconds, and is compiled
+// to native code on a thread of its own once evaluated often enough.
+// evaluations starting after that code is ready run it instead; as the
+// language has no loops, no single evaluation runs long enough to be worth
+// switching over midway. evaluate may be called from any number of
+// threads at once.
+class Tiered {
+  public:
+    static constexpr std::uint64_t never =
+        std::numeric_limits<std::uint64_t>::max();
+
+  private:
+    struct State;
+    std::unique_ptr<State> m_state;
+
+    explicit Tiered(std::unique_ptr<State> state) noexcept;
+
+    friend Tiered prepare(std::string_view                  source,
+                          std::span<std::string_view const> parameters,
+                          TierOptions                       options);
+
+  public:
+    Tiered(Tiered &&other) noexcept;
+    Tiered &operator=(Tiered &&other) noexcept;
+    // waits for a compile in progress to finish.
+    ~Tiered();
+
+    std::size_t  arity() const noexcept;
+    // as Expression::returns_double. such an expression is a constant,
+    // which real gives.
+    bool         returns_double() const noexcept;
+    double       real() const;
+    // whether evaluations now run native code.
+    bool         native() const noexcept;
+
+    // throws inf::Error when arguments are not one per parameter, or the
+    // expression returns a double.
+    std::int64_t evaluate(std::span<std::int64_t const> arguments) const;
+};
+
+// prepare source, as compile takes it, for tiered evaluation. throws
+// inf::Error listing every diagnostic when source does not compile.
+Tiered prepare(std::string_view                   source,
+               std::span<std::string_view const> parameters,
+               TierOptions                        options = {});
+
+// a module of bindings whose functions are only compiled, along with
+// whatever they call, the first time they are called. until then each is a
+// stub, so loading costs parsing and lowering alone however large the
+// module is. functions may be called from any number of threads at once
+// for as long as the Library lives.
+class Library {
+    std::unique_ptr<llvm::orc::LLLazyJIT>        m_jit;
+    // the symbol each binding's function goes by in the JIT.
+    std::unordered_map<std::string, std::string> m_symbols;
+
+    Library(std::unique_ptr<llvm::orc::LLLazyJIT>        jit,
+            std::unordered_map<std::string, std::string> symbols) noexcept;
+
+    friend Library load(std::string_view source, JitOptions options);
+
+  public:
+    using Function = std::int64_t();
+
+    Library(Library &&other) noexcept;
+    Library &operator=(Library &&other) noexcept;
+    ~Library();
+
+    bool      contains(std::string_view name) const;
+    // the last binding of name, as a function of no parameters. throws
+    // inf::Error if nothing binds name. should LLVM fail to compile it on
+    // its first call, the failure is printed and the process aborts, as
+    // there is no caller to return an error to.
+    Function *function(std::string_view name) const;
+};
+
+// load source, a sequence of bindings and no expressions, for compiling on
+// demand. the final ';' may be left off. throws inf::Error listing every
+// diagnostic when source does not compile. compiles are serialized with
+// those of compile, so this may be called from any thread.
+// options.checked is ignored: a binding has no parameters, so one which
+// traps does so on every call.
+Library load(std::string_view source, JitOptions options = {});
+} // namespace inf
+
+#endif // !INF_API_JIT_HPP
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_CODEGEN_HPP
+#define INF_CORE_CODEGEN_HPP
+
+#include <cstdint>
+
+#include "env/context.hpp"
+#include "imr/mir.hpp"
+
+namespace inf {
+struct CodegenOptions {
+    // allow truncating constants and quotients, and rounding doubles.
+    bool round      = false;
+    // attach DWARF subprograms and a location to every instruction, so
+    // that optimization remarks and debuggers can name source statements.
+    bool debug_info = false;
+    // report overflow and division by zero through a trailing
+    // std::int32_t * parameter of every function returning an i64, which
+    // is set to 1, and return 0, rather than trap. a caller returns as soon
+    // as one of its calls has.
+    bool checked    = false;
+};
+
+// emit LLVM IR for module into the context's llvm::Module. every value is
+// an i64; operations not marked Exact64 are checked and trap on overflow,
+// unless options.checked.
+// an entry which folded to a constant that is not an integer returns a
+// double instead. constants which do not fit in 64 bits, or would have to
+// be rounded without options.round, are reported through the context.
+void codegen(Context              &context,
+             mir::Module const    &module,
+             CodegenOptions const &options = {});
+
+// the rules codegen applies to constants and quotients, for anything else
+// executing MIR to agree with. each reports through context what breaks
+// them, returning a placeholder.
+std::int64_t integer_constant(Context        &context,
+                              Rational const &value,
+                              SourceRange     range,
+                              bool            round);
+double       real_constant(Context        &context,
+                           Rational const &value,
+                           SourceRange     range,
+                           bool            round);
+// an entry which folded to a constant that is not an integer returns it as
+// a double instead, so long as the double is exact.
+bool         returns_double(mir::Module const   &module,
+                            mir::Function const &function);
+// reports division by the constant 0, which is what folding leaves of a
+// divisor which is always zero, and quotients which would be truncated.
+void         check_division(Context                &context,
+                            mir::Module const      &module,
+                            mir::Function const    &function,
+                            mir::Instruction const &instruction,
+                            SourceRange             range,
+                            bool                    round);
+} // namespace inf
+
+#endif // !INF_CORE_CODEGEN_HPP
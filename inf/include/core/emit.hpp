@@ -0,0 +1,47 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_EMIT_HPP
+#define INF_CORE_EMIT_HPP
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+
+#include "env/context.hpp"
+
+namespace inf {
+using ObjectBuffer = llvm::SmallVector<char, 0>;
+
+// run the backend over the context's module, producing relocatable object
+// code directly in memory. when partitions > 1 the module is split and each
+// partition is compiled on its own thread, in the manner of
+// llvm::splitCodeGen, yielding one object per partition.
+std::vector<ObjectBuffer> emit_objects(Context &context, unsigned partitions);
+
+// the path object number index is written to; index 0 is path itself,
+// index N > 0 is path with ".N" inserted before the extension.
+std::string object_path(std::string_view path, std::size_t index);
+
+// write each object to object_path(path, index) with a single mapped
+// FileOutputBuffer commit per file.
+void write_objects(std::string_view                path,
+                   std::span<ObjectBuffer const> objects);
+} // namespace inf
+
+#endif // !INF_CORE_EMIT_HPP
@@ -0,0 +1,42 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_INTERPRET_HPP
+#define INF_CORE_INTERPRET_HPP
+
+#include <cstdint>
+#include <span>
+
+#include "env/context.hpp"
+#include "imr/bytecode.hpp"
+#include "imr/mir.hpp"
+
+namespace inf {
+// translate module to bytecode, reporting through the context whatever
+// codegen would; the result is only meaningful when no errors were added.
+// round is CodegenOptions::round.
+bytecode::Program assemble(Context           &context,
+                           mir::Module const &module,
+                           bool               round = false);
+
+// evaluate the program's entry on arguments, one per parameter. overflow
+// and division by zero trap, as they do in compiled code. the program is
+// only read, so any number of threads may evaluate it at once.
+std::int64_t interpret(bytecode::Program const       &program,
+                       std::span<std::int64_t const> arguments);
+} // namespace inf
+
+#endif // !INF_CORE_INTERPRET_HPP
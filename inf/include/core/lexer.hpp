@@ -17,14 +17,18 @@
 #ifndef INF_CORE_LEX_HPP
 #define INF_CORE_LEX_HPP
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
 #include <variant>
+#include <vector>
 
 #include "boost/assert.hpp"
 
-#include "llvm/IR/Constants.h"
-
 #include "env/context.hpp"
 #include "imr/location.hpp"
+#include "imr/number.hpp"
 
 namespace yy {
 class Lexer {
@@ -32,11 +36,15 @@ class Lexer {
     char const *token;
     char const *marker;
     char const *cursor;
-    char const *limit;
-    location    location_;
+    char const   *limit;
+    inf::Location base;
     inf::Context *context;
+    // the number of bytes of a stream discarded before buffer.
+    std::uint32_t consumed;
 
-    void up();
+    inf::Location location_of(char const *p) const noexcept {
+        return base + consumed + static_cast<std::uint32_t>(p - buffer);
+    }
 
   public:
     struct Token {
@@ -50,7 +58,8 @@ class Lexer {
         struct Star {};
         struct FSlash {};
         struct Percent {};
-        struct Integer { llvm::ConstantInt *integer; };
+        struct Equals {};
+        struct Label { inf::Label label; };
 
         using Variant = std::variant<End,
                                      Error,
@@ -62,18 +71,26 @@ class Lexer {
                                      Star,
                                      FSlash,
                                      Percent,
-                                     Integer>;
-        Variant variant;
-        Token() : variant(End{}) {}
-        Token(Token &&token) : variant(std::move(token.variant)) {}
-        Token(Token const &token) : variant(token.variant) {}
-        template <class T> Token(T &&t) : variant(std::move(t)) {}
-        template <class T> Token(T const &t) : variant(t) {}
+                                     Equals,
+                                     Label,
+                                     inf::Integer,
+                                     inf::Rational>;
+        Variant          variant;
+        inf::SourceRange range;
+
+        Token() : variant(End{}), range() {}
+        Token(Token &&token)
+            : variant(std::move(token.variant)), range(token.range) {}
+        Token(Token const &token)
+            : variant(token.variant), range(token.range) {}
+        template <class T> Token(T &&t) : variant(std::move(t)), range() {}
+        template <class T> Token(T const &t) : variant(t), range() {}
 
         Token &operator=(Token &&other) {
             if (&other == this) { return *this; }
 
             variant = std::move(other.variant);
+            range   = other.range;
             return *this;
         }
 
@@ -81,6 +98,7 @@ class Lexer {
             if (&other == this) { return *this; }
 
             variant = other.variant;
+            range   = other.range;
             return *this;
         }
 
@@ -105,15 +123,80 @@ class Lexer {
         template <class T> T const &as() const { return std::get<T>(variant); }
     };
 
-    Lexer()
-        : buffer(nullptr), token(nullptr), cursor(nullptr), limit(nullptr) {}
+    // reads at most size bytes into data, returning how many were read.
+    // zero means the input has ended.
+    using Read = std::function<std::size_t(char *data, std::size_t size)>;
+
+  private:
+    // input read incrementally into a fixed size buffer, see set_stream.
+    struct Stream {
+        Read                       read;
+        std::unique_ptr<char[]>    storage;
+        std::size_t                capacity;
+        bool                       ended;
+        bool                       closed;
+        // relative to base, as SourceManager::File::line_starts.
+        std::vector<std::uint32_t> line_starts;
+    };
 
-    void set_view(std::string_view view) noexcept {
+    // when set, errors are recorded here rather than in the context, so
+    // lexers on different threads never share a list.
+    inf::ErrorList         *errors;
+    // when not empty, advance() hands these out instead of scanning.
+    std::span<Token>        replay;
+    std::unique_ptr<Stream> stream;
+
+    Token                     scan();
+    inf::ErrorList::size_type report(inf::Error error);
+    // re2c's YYFILL: make room for and read more of the stream, returning
+    // zero if anything was read.
+    int fill();
+
+  public:
+    Lexer()
+        : buffer(nullptr), token(nullptr), marker(nullptr), cursor(nullptr),
+          limit(nullptr), base(), context(nullptr), consumed(0),
+          errors(nullptr), replay(), stream() {}
+    explicit Lexer(inf::Context *context)
+        : buffer(nullptr), token(nullptr), marker(nullptr), cursor(nullptr),
+          limit(nullptr), base(), context(context), consumed(0),
+          errors(nullptr), replay(), stream() {}
+
+    // base is the location of view[0], as given by the SourceManager. view
+    // need not be followed by a '\0', but must end between tokens.
+    void set_view(std::string_view view, inf::Location base = {}) noexcept {
         buffer = token = cursor = view.data();
         limit                   = view.data() + view.length();
+        this->base              = base;
+        consumed                = 0;
+        stream.reset();
     }
 
-    location const &loc() const noexcept { return location_; }
+    // lex text from read through a buffer of capacity bytes, which only
+    // grows if a single token is longer. base is the location returned by
+    // SourceManager::open, the lexer closes the file once read runs dry.
+    void set_stream(Read          read,
+                    inf::Location base,
+                    std::size_t   capacity = 64 * 1024);
+
+    // close the streamed file at what has been read so far. advance() does
+    // this at the end of the input, so it is only needed when the parser
+    // gives up early.
+    void close();
+
+    void set_errors(inf::ErrorList *errors) noexcept {
+        this->errors = errors;
+    }
+
+    // replay tokens lexed ahead of time, as by inf::tokenize. each token
+    // is moved out of tokens as it is handed to the parser, and the last
+    // should be Token::End.
+    void set_tokens(std::span<Token> tokens) noexcept { replay = tokens; }
+
+    // the range of the most recently scanned token.
+    inf::SourceRange loc() const noexcept {
+        return {location_of(token), location_of(cursor)};
+    }
 
     Token advance();
 };
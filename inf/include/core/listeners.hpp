@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_LISTENERS_HPP
+#define INF_CORE_LISTENERS_HPP
+
+#include <memory>
+
+#include "env/context.hpp"
+#include "imr/mir.hpp"
+
+namespace llvm::orc {
+class ExecutionSession;
+class ObjectLayer;
+} // namespace llvm::orc
+
+namespace inf {
+// the tools told about code as a JIT loads it, so that they can name it.
+struct JitListeners {
+    // append to /tmp/perf-<pid>.map, which perf report reads as is, and
+    // when LLVM was built with perf support also write a jitdump for
+    // perf inject --jit.
+    bool perf = false;
+    // register each object, with its debug info, through GDB's JIT
+    // interface.
+    bool gdb  = false;
+
+    bool any() const noexcept { return perf || gdb; }
+
+    // INF_JIT_PERF and INF_JIT_GDB, each enabled when set to anything
+    // other than 0.
+    static JitListeners from_environment();
+};
+
+// name each function of module label@file:line.column after the statement
+// it was lowered from, so a profile attributes time to that statement.
+// must run after codegen and before the module is optimized.
+void name_by_location(Context &context, mir::Module const &module);
+
+// an object linking layer announcing every object it loads to listeners,
+// for LLJITBuilder::setObjectLinkingLayerCreator.
+std::unique_ptr<llvm::orc::ObjectLayer>
+listening_layer(llvm::orc::ExecutionSession &session, JitListeners listeners);
+} // namespace inf
+
+#endif // !INF_CORE_LISTENERS_HPP
@@ -0,0 +1,40 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_LOWER_HPP
+#define INF_CORE_LOWER_HPP
+
+#include <span>
+
+#include "env/context.hpp"
+#include "imr/ast.hpp"
+#include "imr/mir.hpp"
+
+namespace inf {
+// lower parsed statements to MIR. each binding becomes a function of no
+// parameters and each expression statement an entry function taking the
+// given parameters, which are in scope in entries alone and shadow any
+// binding of the same name. the last binding of each label in exports is
+// kept and visible outside the module. unresolved names are reported
+// through the context; the result is only meaningful when no errors were
+// added.
+mir::Module lower(Context                  &context,
+                  std::span<Ast::Ptr const> statements,
+                  std::span<Label const>    parameters = {},
+                  std::span<Label const>    exports    = {});
+} // namespace inf
+
+#endif // !INF_CORE_LOWER_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_OPTIMIZE_HPP
+#define INF_CORE_OPTIMIZE_HPP
+
+#include "env/context.hpp"
+
+namespace llvm {
+class Module;
+class TargetMachine;
+} // namespace llvm
+
+namespace inf {
+// run LLVM's default per-module pipeline for level (0 to 3) over the
+// context's module.
+void optimize(Context &context, unsigned level);
+
+// the same over any module, tuned for target_machine when not null.
+void optimize(llvm::Module        &module,
+              llvm::TargetMachine *target_machine,
+              unsigned             level);
+} // namespace inf
+
+#endif // !INF_CORE_OPTIMIZE_HPP
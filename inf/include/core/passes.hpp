@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_PASSES_HPP
+#define INF_CORE_PASSES_HPP
+
+#include "imr/mir.hpp"
+
+// cheap MIR passes which use what LLVM cannot know: integers are exact,
+// and bindings are pure.
+namespace inf::mir {
+// merges identical instructions, folds operations on constants exactly,
+// applies algebraic identities and replaces calls to bindings which fold
+// to a constant with that constant.
+void number_values(Module &module);
+
+// only the folding of number_values, followed by remove_dead_bindings.
+// codegen rejects constants which are neither integers nor results, so
+// this runs even when the other passes do not.
+void fold_constants(Module &module);
+
+// removes instructions whose value is never used, and then functions
+// which no entry can reach.
+void remove_dead_bindings(Module &module);
+
+// interval analysis over exact integers. marks each operation whose result
+// provably fits in 64 bits as Exact64, and each division whose divisor is
+// provably non-zero as NonZeroDivisor.
+void analyze_ranges(Module &module);
+
+// all of the above, in order.
+void optimize(Module &module);
+} // namespace inf::mir
+
+#endif // !INF_CORE_PASSES_HPP
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_REACHABLE_HPP
+#define INF_CORE_REACHABLE_HPP
+
+#include <span>
+#include <vector>
+
+#include "env/context.hpp"
+#include "imr/ast.hpp"
+
+namespace inf {
+// drop every binding which neither an entry nor the last binding of a label
+// in exports depends on, before any work is spent lowering it. references
+// resolve as in lower, to the last binding of the label before the
+// statement. names which nothing binds are reported through the context
+// for the statements dropped alone; lower reports the rest, along with
+// exports which name no binding.
+void retain_reachable(Context                &context,
+                      std::vector<Ast::Ptr>  &statements,
+                      std::span<Label const> exports = {});
+} // namespace inf
+
+#endif // !INF_CORE_REACHABLE_HPP
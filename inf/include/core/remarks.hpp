@@ -0,0 +1,81 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_REMARKS_HPP
+#define INF_CORE_REMARKS_HPP
+
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "llvm/Support/Regex.h"
+#include "llvm/Support/ToolOutputFile.h"
+
+#include "env/context.hpp"
+
+namespace inf {
+// optimization remarks from LLVM's passes, streamed to a file as they are
+// emitted and kept for a summary. LLVM only builds remarks while a
+// streamer is installed on the LLVMContext, so compiling without a
+// Remarks costs nothing.
+class Remarks {
+  public:
+    struct Remark {
+        enum class Kind { Passed, Missed, Analysis } kind;
+        std::string function;
+        std::string pass;
+        std::string message;
+        // empty unless codegen emitted debug info.
+        std::string file;
+        unsigned    line;
+        unsigned    column;
+    };
+
+  private:
+    Context                              *context;
+    std::optional<llvm::Regex>            filter;
+    std::unique_ptr<llvm::ToolOutputFile> file;
+    std::vector<Remark>                   remarks;
+
+    class Collector;
+
+  public:
+    // collect remarks from the passes whose names match the regular
+    // expression filter, an empty filter matching every pass, into path
+    // in format "yaml" or "bitstream". throws inf::Error when any of them
+    // is bad.
+    Remarks(Context         &context,
+            std::string_view path,
+            std::string_view filter,
+            std::string_view format);
+    Remarks(Remarks const &) = delete;
+    ~Remarks();
+
+    // stop collecting and keep the file.
+    void finish();
+
+    std::vector<Remark> const &collected() const noexcept { return remarks; }
+
+    // print, for each statement, how many optimizations were applied and
+    // where each missed one was.
+    void summarize(std::ostream &out) const;
+};
+} // namespace inf
+
+#endif // !INF_CORE_REMARKS_HPP
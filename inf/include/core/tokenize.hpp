@@ -0,0 +1,36 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_CORE_TOKENIZE_HPP
+#define INF_CORE_TOKENIZE_HPP
+
+#include <vector>
+
+#include "core/lexer.hpp"
+#include "env/context.hpp"
+
+namespace inf {
+// lex the whole of the file at source into a token array ending in
+// Token::End. the file is split after ';' into at most threads chunks,
+// which are lexed in parallel; no token spans a ';', and locations are
+// offsets, so the chunks need no fix-up afterwards. the tokens, and the
+// errors recorded in the context, are identical to lexing the file with a
+// single yy::Lexer.
+std::vector<yy::Lexer::Token>
+tokenize(Context &context, Location source, unsigned threads);
+} // namespace inf
+
+#endif // !INF_CORE_TOKENIZE_HPP
@@ -17,7 +17,11 @@
 #ifndef INF_ENV_CONTEXT_HPP
 #define INF_ENV_CONTEXT_HPP
 
+#include <mutex>
+
 #include "env/error_list.hpp"
+#include "env/memory.hpp"
+#include "env/source_manager.hpp"
 #include "imr/label.hpp"
 
 #include "llvm/ADT/StringSet.h"
@@ -25,24 +29,61 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Target/TargetMachine.h"
+#include "llvm/TargetParser/Triple.h"
 
 namespace inf {
 class Context {
-    llvm::TargetMachine *llvm_target_machine;
-    llvm::LLVMContext    llvm_context;
-    llvm::Module         llvm_module;
-    llvm::IRBuilder<>    llvm_ir_builder;
-    llvm::StringSet<>    string_interner;
-    ErrorList            error_list;
+    TrackingResource                     memory_resource;
+    llvm::Triple                         llvm_triple;
+    std::string                          llvm_cpu;
+    std::string                          llvm_cpu_features;
+    std::unique_ptr<llvm::TargetMachine> llvm_target_machine;
+    llvm::LLVMContext                    llvm_context;
+    llvm::Module                         llvm_module;
+    llvm::IRBuilder<>                    llvm_ir_builder;
+    std::mutex                           string_interner_mutex;
+    llvm::StringSet<ResourceAllocator>   string_interner;
+    SourceManager                        source_manager;
+    ErrorList                            error_list;
+    std::pmr::memory_resource           *ast_memory_resource;
 
     static std::string host_cpu_features() noexcept;
 
   public:
     Context(Label module_name);
 
+    // every allocation made on behalf of this context is attributed to the
+    // phase current on this resource.
+    TrackingResource &memory() noexcept { return memory_resource; }
+
+    // where the parser allocates the ast: memory() unless pointed at an
+    // arena, which must then outlive every node parsed into it.
+    std::pmr::memory_resource *ast_memory() const noexcept {
+        return ast_memory_resource;
+    }
+    void ast_memory(std::pmr::memory_resource *resource) noexcept {
+        ast_memory_resource = resource;
+    }
+
+    SourceManager       &sources() noexcept { return source_manager; }
+    SourceManager const &sources() const noexcept { return source_manager; }
+
+    // each call returns a fresh TargetMachine configured for the host, so
+    // that parallel code generation threads never share one.
+    std::unique_ptr<llvm::TargetMachine> create_target_machine() const;
+
+    llvm::TargetMachine &target_machine() noexcept {
+        return *llvm_target_machine;
+    }
+    llvm::LLVMContext &ir_context() noexcept { return llvm_context; }
+    llvm::Module      &module() noexcept { return llvm_module; }
+    llvm::IRBuilder<> &builder() noexcept { return llvm_ir_builder; }
+
     ErrorList::size_type error(Error error);
     Error const         &error_at(ErrorList::size_type index) const;
+    ErrorList const     &errors() const noexcept { return error_list; }
 
+    // safe to call from several threads at once, as parallel lexing does.
     Label intern_string(llvm::StringRef string);
 };
 } // namespace inf
@@ -17,12 +17,16 @@
 #ifndef INF_ENV_ERROR_LIST_HPP
 #define INF_ENV_ERROR_LIST_HPP
 
+#include <memory_resource>
 #include <vector>
 
 #include "imr/error.hpp"
 
 namespace inf {
-class ErrorList : public std::vector<Error> {};
-}
+class ErrorList : public std::pmr::vector<Error> {
+  public:
+    using std::pmr::vector<Error>::vector;
+};
+} // namespace inf
 
 #endif // !INF_ENV_ERROR_LIST_HPP
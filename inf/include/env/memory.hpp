@@ -0,0 +1,161 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_ENV_MEMORY_HPP
+#define INF_ENV_MEMORY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <ostream>
+
+#include "llvm/Support/AllocatorBase.h"
+
+namespace inf {
+enum class Phase : std::uint8_t {
+    Setup,
+    Parse,
+    Lower,
+    Optimize,
+    Emit,
+};
+
+inline constexpr std::size_t phase_count = 5;
+
+char const *to_string(Phase phase) noexcept;
+
+inline std::ostream &operator<<(std::ostream &out, Phase phase) {
+    return out << to_string(phase);
+}
+
+struct AllocationStats {
+    std::size_t allocated_bytes   = 0;
+    std::size_t deallocated_bytes = 0;
+    std::size_t allocations       = 0;
+    std::size_t deallocations     = 0;
+    // the highest number of live bytes, across all phases, observed while
+    // this phase was current.
+    std::size_t peak_bytes        = 0;
+};
+
+// forwards every request to an upstream resource and attributes it to the
+// current compilation phase. counters are atomic so that worker threads may
+// share one resource; the phase itself is only changed by the driver.
+class TrackingResource : public std::pmr::memory_resource {
+    struct Counters {
+        std::atomic<std::size_t> allocated_bytes;
+        std::atomic<std::size_t> deallocated_bytes;
+        std::atomic<std::size_t> allocations;
+        std::atomic<std::size_t> deallocations;
+        std::atomic<std::size_t> peak_bytes;
+    };
+
+    std::pmr::memory_resource        *upstream;
+    std::atomic<Phase>                current;
+    std::atomic<std::size_t>          live_bytes;
+    std::array<Counters, phase_count> counters;
+
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void  do_deallocate(void       *pointer,
+                        std::size_t bytes,
+                        std::size_t alignment) override;
+    bool  do_is_equal(
+         std::pmr::memory_resource const &other) const noexcept override;
+
+  public:
+    explicit TrackingResource(
+        std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+    Phase phase() const noexcept { return current.load(); }
+    void  phase(Phase phase) noexcept { current.store(phase); }
+
+    // account for memory obtained elsewhere, e.g. GMP limbs.
+    void record_allocation(std::size_t bytes) noexcept;
+    void record_deallocation(std::size_t bytes) noexcept;
+
+    AllocationStats stats(Phase phase) const noexcept;
+    std::size_t     live() const noexcept { return live_bytes.load(); }
+
+    void report(std::ostream &out) const;
+};
+
+// switches the resource to a phase for the lifetime of the scope.
+class PhaseScope {
+    TrackingResource *resource;
+    Phase             previous;
+
+  public:
+    PhaseScope(TrackingResource &resource, Phase phase) noexcept
+        : resource(&resource), previous(resource.phase()) {
+        resource.phase(phase);
+    }
+    PhaseScope(PhaseScope const &) = delete;
+    ~PhaseScope() { resource->phase(previous); }
+
+    PhaseScope &operator=(PhaseScope const &) = delete;
+};
+
+// bump allocation for data that lives exactly as long as a phase; nothing
+// is returned upstream until the arena itself is destroyed.
+class Arena : public std::pmr::monotonic_buffer_resource {
+  public:
+    explicit Arena(std::pmr::memory_resource *upstream)
+        : std::pmr::monotonic_buffer_resource(upstream) {}
+    Arena(std::size_t initial_size, std::pmr::memory_resource *upstream)
+        : std::pmr::monotonic_buffer_resource(initial_size, upstream) {}
+};
+
+// adapts a memory_resource to LLVM's allocator interface, for containers
+// such as llvm::StringSet.
+class ResourceAllocator : public llvm::AllocatorBase<ResourceAllocator> {
+    std::pmr::memory_resource *resource;
+
+  public:
+    ResourceAllocator() noexcept
+        : resource(std::pmr::new_delete_resource()) {}
+    ResourceAllocator(std::pmr::memory_resource *resource) noexcept
+        : resource(resource) {}
+
+    void *Allocate(std::size_t size, std::size_t alignment) {
+        return resource->allocate(size, alignment);
+    }
+
+    void Deallocate(void const *pointer,
+                    std::size_t size,
+                    std::size_t alignment) {
+        resource->deallocate(const_cast<void *>(pointer), size, alignment);
+    }
+
+    using llvm::AllocatorBase<ResourceAllocator>::Allocate;
+    using llvm::AllocatorBase<ResourceAllocator>::Deallocate;
+};
+
+// routes GMP's limb allocation through malloc/realloc/free while recording
+// it in resource, for the lifetime of the scope. GMP's hooks are process
+// wide, so only the driver should create one of these.
+class GmpAllocationScope {
+  public:
+    explicit GmpAllocationScope(TrackingResource &resource) noexcept;
+    GmpAllocationScope(GmpAllocationScope const &) = delete;
+    ~GmpAllocationScope();
+
+    GmpAllocationScope &operator=(GmpAllocationScope const &) = delete;
+};
+} // namespace inf
+
+#endif // !INF_ENV_MEMORY_HPP
@@ -17,6 +17,44 @@
 #ifndef INF_ENV_OPTIONS_HPP
 #define INF_ENV_OPTIONS_HPP
 
+#include <string>
+#include <string_view>
+#include <vector>
 
+namespace inf {
+struct Options {
+    // "-" reads stdin, which is lexed as it arrives unless lexing in
+    // parallel, which needs the whole text.
+    std::string input;
+    std::string output             = "a.o";
+    unsigned    lex_threads        = 1;
+    // -j N writes N objects, one per partition: output itself, then
+    // output with ".1" through ".N-1" inserted before its extension. all
+    // of them must be linked.
+    unsigned    emit_threads       = 1;
+    unsigned    optimization_level = 2;
+    // run the MIR passes before handing the module to LLVM. constants are
+    // folded exactly either way.
+    bool        mir_passes         = true;
+    // allow rounding values which are not exact at runtime.
+    bool        round              = false;
+    bool        memory_report      = false;
+    // write LLVM optimization remarks to this file, when not empty.
+    std::string remarks;
+    std::string remarks_filter;
+    std::string remarks_format     = "yaml";
+    // print the remarks per statement to stderr once compiled.
+    bool        remarks_summary    = false;
+    // bindings kept with external linkage. only these, the entries, and
+    // what they refer to are compiled.
+    std::vector<std::string> exports;
+    // print usage and exit.
+    bool                     help = false;
+
+    // throws inf::Error describing the first malformed argument.
+    static Options          parse(int argc, char const *const *argv);
+    static std::string_view usage() noexcept;
+};
+} // namespace inf
 
 #endif // !INF_ENV_OPTIONS_HPP
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_ENV_SOURCE_MANAGER_HPP
+#define INF_ENV_SOURCE_MANAGER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "imr/location.hpp"
+
+namespace inf {
+// owns every buffer handed to the compiler and lays them out one after
+// another in a single 32-bit address space, so that a Location is just an
+// offset. each file occupies size + 1 offsets, the last being its end.
+// a streamed file is given offsets but its text is never kept, only where
+// its lines begin.
+class SourceManager {
+  public:
+    struct File {
+        std::unique_ptr<llvm::MemoryBuffer> buffer;
+        Location                            base;
+        // the size of buffer, or of the text read so far by a streamed file.
+        // an open stream extends to the end of the address space.
+        std::uint32_t extent;
+        // offsets, relative to base, of the first byte of each line. built
+        // the first time a location within the file is presumed.
+        mutable std::vector<std::uint32_t> line_starts;
+
+        llvm::StringRef name() const noexcept {
+            return buffer->getBufferIdentifier();
+        }
+        std::string_view text() const noexcept {
+            return {buffer->getBufferStart(), buffer->getBufferSize()};
+        }
+        std::uint32_t size() const noexcept { return extent; }
+        bool contains(Location location) const noexcept {
+            return base <= location && location <= base + size();
+        }
+    };
+
+    // the human readable form of a location.
+    struct Presumed {
+        llvm::StringRef file;
+        std::uint32_t   line;
+        std::uint32_t   column;
+    };
+
+  private:
+    std::vector<File> files;
+    std::uint32_t     next;
+    bool              streaming;
+
+  public:
+    SourceManager() noexcept : files(), next(1), streaming(false) {}
+
+    // take ownership of buffer, returning the location of its first byte.
+    // buffer must be null terminated, the lexer relies on the sentinel.
+    Location add(std::unique_ptr<llvm::MemoryBuffer> buffer);
+    // copy text into a new buffer named name.
+    Location add(std::string_view name, std::string_view text);
+
+    // begin a file named name whose text is read incrementally, returning
+    // the location of its first byte. nothing else may be added until it
+    // is closed.
+    Location open(std::string_view name);
+    // end the streamed file at base after size bytes. line_starts are the
+    // offsets, relative to base, of the first byte of each line.
+    void close(Location                   base,
+               std::uint32_t              size,
+               std::vector<std::uint32_t> line_starts);
+
+    // the file containing location, or nullptr.
+    File const *file(Location location) const noexcept;
+
+    // the text of the file containing location, starting at location. empty
+    // within a streamed file.
+    std::string_view text(Location location) const noexcept;
+
+    Presumed presume(Location location) const;
+
+    // file:line.column[-line.column]
+    void print(std::ostream &out, SourceRange range) const;
+};
+} // namespace inf
+
+#endif // !INF_ENV_SOURCE_MANAGER_HPP
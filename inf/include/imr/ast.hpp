@@ -18,12 +18,15 @@
 #define INF_IMR_AST_HPP
 
 #include <memory>
+#include <memory_resource>
 #include <variant>
 
 #include "llvm/IR/Type.h"
 #include "llvm/IR/Value.h"
 
 #include "imr/label.hpp"
+#include "imr/location.hpp"
+#include "imr/number.hpp"
 
 namespace inf {
 class Ast : public std::enable_shared_from_this<Ast> {
@@ -35,6 +38,10 @@ class Ast : public std::enable_shared_from_this<Ast> {
   public:
     using Ptr = std::shared_ptr<Ast>;
 
+    struct Variable {
+        Label label;
+    };
+
     struct Binding {
         Label             label;
         llvm::Type const *type;
@@ -62,16 +69,27 @@ class Ast : public std::enable_shared_from_this<Ast> {
         Ptr right;
     };
 
-    using Variant = std::variant<llvm::Value *, Binding, Unop, Binop>;
+    using Variant = std::variant<std::monostate,
+                                 llvm::Value *,
+                                 Integer,
+                                 Rational,
+                                 Variable,
+                                 Binding,
+                                 Unop,
+                                 Binop>;
 
   private:
-    Variant variant;
+    SourceRange range;
+    Variant     variant;
 
   public:
-    Ast(Private) : variant() {}
-    Ast(Private, Ast &&ast) : variant(std::move(ast.variant)) {}
+    Ast(Private) : range(), variant() {}
+    Ast(Private, Ast &&ast)
+        : range(ast.range), variant(std::move(ast.variant)) {}
     Ast(Ast const &ast) = delete;
-    template <class T> Ast(Private, T &&t) : variant(std::move(t)) {}
+    template <class T>
+    Ast(Private, SourceRange range, T &&t)
+        : range(range), variant(std::move(t)) {}
     template <class T> Ast(T const &t) = delete;
 
     template <class T> Ast &operator=(T &&t) {
@@ -84,12 +102,15 @@ class Ast : public std::enable_shared_from_this<Ast> {
     Ast &operator=(Ast &&other) {
         if (this == &other) { return *this; }
 
+        range   = other.range;
         variant = std::move(other.variant);
         return *this;
     }
 
     Ast &operator=(Ast const &other) = delete;
 
+    SourceRange location() const noexcept { return range; }
+
     Variant       &get() noexcept { return variant; }
     Variant const &get() const noexcept { return variant; }
 
@@ -100,49 +121,99 @@ class Ast : public std::enable_shared_from_this<Ast> {
     template <class T> T       &as() { return std::get<T>(variant); }
     template <class T> T const &as() const { return std::get<T>(variant); }
 
-    static Ptr create() {
-        return std::make_shared<Ast>(Private{}, std::monostate{});
+    // nodes are allocated from the resource given, which the parser takes
+    // from Context::ast_memory.
+    using Allocator = std::pmr::polymorphic_allocator<Ast>;
+    using Resource  = std::pmr::memory_resource;
+
+    static Ptr create(Resource *resource, SourceRange range) {
+        return std::allocate_shared<Ast>(
+            Allocator{resource}, Private{}, range, std::monostate{});
     }
 
-    template <class T> static Ptr create(T &&t) {
-        return std::make_shared<Ast>(Private{}, std::move(t));
+    template <class T>
+    static Ptr create(Resource *resource, SourceRange range, T &&t) {
+        return std::allocate_shared<Ast>(
+            Allocator{resource}, Private{}, range, std::move(t));
     }
 
-    template <class T> static Ptr create(T const &t) {
-        return std::make_shared<Ast>(Private{}, t);
+    template <class T>
+    static Ptr create(Resource *resource, SourceRange range, T const &t) {
+        return std::allocate_shared<Ast>(
+            Allocator{resource}, Private{}, range, t);
     }
 
-    static Ptr binding(Label label, llvm::Type const *type, Ptr expression) {
-        return create(Binding{label, std::move(type), std::move(expression)});
+    static Ptr variable(Resource *resource, SourceRange range, Label label) {
+        return create(resource, range, Variable{label});
     }
 
-    static Ptr negate(Ptr expression) {
-        return create(Unop{Unop::Opcode::Negate, std::move(expression)});
+    static Ptr binding(Resource         *resource,
+                       SourceRange       range,
+                       Label             label,
+                       llvm::Type const *type,
+                       Ptr               expression) {
+        return create(resource,
+                      range,
+                      Binding{label, std::move(type), std::move(expression)});
     }
 
-    static Ptr add(Ptr left, Ptr right) {
-        return create(
-            Binop{Binop::Opcode::Add, std::move(left), std::move(right)});
+    static Ptr negate(Resource *resource, SourceRange range, Ptr expression) {
+        return create(resource,
+                      range,
+                      Unop{Unop::Opcode::Negate, std::move(expression)});
     }
 
-    static Ptr subtract(Ptr left, Ptr right) {
+    static Ptr binop(Resource     *resource,
+                     SourceRange   range,
+                     Binop::Opcode opcode,
+                     Ptr           left,
+                     Ptr           right) {
         return create(
-            Binop{Binop::Opcode::Subtract, std::move(left), std::move(right)});
+            resource, range, Binop{opcode, std::move(left), std::move(right)});
     }
 
-    static Ptr multiply(Ptr left, Ptr right) {
-        return create(
-            Binop{Binop::Opcode::Multiply, std::move(left), std::move(right)});
+    static Ptr add(Resource *resource, SourceRange range, Ptr left, Ptr right) {
+        return binop(resource,
+                     range,
+                     Binop::Opcode::Add,
+                     std::move(left),
+                     std::move(right));
     }
 
-    static Ptr divide(Ptr left, Ptr right) {
-        return create(
-            Binop{Binop::Opcode::Divide, std::move(left), std::move(right)});
+    static Ptr
+    subtract(Resource *resource, SourceRange range, Ptr left, Ptr right) {
+        return binop(resource,
+                     range,
+                     Binop::Opcode::Subtract,
+                     std::move(left),
+                     std::move(right));
     }
 
-    static Ptr modulo(Ptr left, Ptr right) {
-        return create(
-            Binop{Binop::Opcode::Modulo, std::move(left), std::move(right)});
+    static Ptr
+    multiply(Resource *resource, SourceRange range, Ptr left, Ptr right) {
+        return binop(resource,
+                     range,
+                     Binop::Opcode::Multiply,
+                     std::move(left),
+                     std::move(right));
+    }
+
+    static Ptr
+    divide(Resource *resource, SourceRange range, Ptr left, Ptr right) {
+        return binop(resource,
+                     range,
+                     Binop::Opcode::Divide,
+                     std::move(left),
+                     std::move(right));
+    }
+
+    static Ptr
+    modulo(Resource *resource, SourceRange range, Ptr left, Ptr right) {
+        return binop(resource,
+                     range,
+                     Binop::Opcode::Modulo,
+                     std::move(left),
+                     std::move(right));
     }
 };
 } // namespace inf
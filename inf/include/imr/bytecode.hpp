@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_IMR_BYTECODE_HPP
+#define INF_IMR_BYTECODE_HPP
+
+#include <cstdint>
+#include <vector>
+
+// a register machine for evaluating a module without compiling it. each
+// function's registers are its parameters, then its constants, then one
+// for each instruction's result, so neither parameters nor constants cost
+// an instruction to read.
+namespace inf::bytecode {
+// the Exact variants are those the MIR passes proved cannot overflow, and
+// so need no check. the order is that of the interpreter's jump table.
+enum class Opcode : std::uint8_t {
+    Negate,
+    NegateExact,
+    Add,
+    AddExact,
+    Subtract,
+    SubtractExact,
+    Multiply,
+    MultiplyExact,
+    Divide,
+    DivideExact,
+    Modulo,
+    ModuloExact,
+    // target = the function numbered a, of no parameters.
+    Call,
+    // the function's result is register a.
+    Return,
+};
+
+struct Instruction {
+    Opcode        opcode;
+    std::uint32_t target;
+    std::uint32_t a;
+    std::uint32_t b;
+};
+
+struct Function {
+    std::uint32_t             parameters;
+    std::uint32_t             registers;
+    std::vector<std::int64_t> constants;
+    // ends in a Return.
+    std::vector<Instruction>  instructions;
+};
+
+struct Program {
+    std::vector<Function> functions;
+    std::uint32_t         entry;
+    // an entry which folded to a constant that is not an integer has no
+    // code, only this.
+    bool                  returns_double;
+    double                real;
+};
+} // namespace inf::bytecode
+
+#endif // !INF_IMR_BYTECODE_HPP
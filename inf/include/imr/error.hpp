@@ -26,13 +26,6 @@
 
 #include "imr/location.hpp"
 
-inline std::ostream &operator<<(std::ostream               &out,
-                                std::source_location const &location) {
-    out << location.file_name() << ":" << location.function_name() << ":"
-        << location.line() << "." << location.column();
-    return out;
-}
-
 namespace inf {
 class Error : public std::exception {
   public:
@@ -49,21 +42,26 @@ class Error : public std::exception {
 
   private:
     std::string m_message;
+    SourceRange m_range;
 
   public:
     Error() {}
-    Error(Error &&other) noexcept : m_message(std::move(other.m_message)) {}
-    Error(Error const &other) : m_message(other.m_message) {}
+    Error(Error &&other) noexcept
+        : m_message(std::move(other.m_message)), m_range(other.m_range) {}
+    Error(Error const &other)
+        : m_message(other.m_message), m_range(other.m_range) {}
     Error(std::string message) : m_message(std::move(message)) {}
-    Error(std::string message, yy::location location) {
-        std::ostringstream stream;
-        stream << "@[" << location << "]\n" << message;
-        m_message = std::move(stream).str();
-    }
+    // the range is kept compact; SourceManager::print turns it into
+    // file:line.column when the error is reported.
+    Error(std::string message, SourceRange range)
+        : m_message(std::move(message)), m_range(range) {}
 
     Error(std::string message, Internal internal) {
-        std::ostringstream stream;
-        stream << internal.trace << "\n@[" << internal.location << "]\n"
+        std::source_location const &location = internal.location;
+        std::ostringstream          stream;
+        stream << internal.trace << "\n@[" << location.file_name() << ":"
+               << location.function_name() << ":" << location.line() << "."
+               << location.column() << "]\n"
                << message;
         m_message = std::move(stream).str();
     }
@@ -71,12 +69,14 @@ class Error : public std::exception {
     Error &operator=(Error &&other) noexcept {
         if (this == &other) { return *this; }
         m_message = std::move(other.m_message);
+        m_range   = other.m_range;
         return *this;
     }
 
     Error &operator=(Error const &other) {
         if (this == &other) { return *this; }
         m_message = other.m_message;
+        m_range   = other.m_range;
         return *this;
     }
 
@@ -87,6 +87,7 @@ class Error : public std::exception {
     char const *what() const noexcept override { return m_message.c_str(); }
 
     std::string const &message() const noexcept { return m_message; }
+    SourceRange        range() const noexcept { return m_range; }
 
     friend std::ostream &operator<<(std::ostream &out, Error const &error);
 };
@@ -0,0 +1,105 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_IMR_MIR_HPP
+#define INF_IMR_MIR_HPP
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "imr/label.hpp"
+#include "imr/location.hpp"
+#include "imr/number.hpp"
+
+// the mid-level IR sits between inf::Ast and LLVM IR. a function is a flat
+// array of instructions in SSA form; an instruction's value is its index,
+// and operands are indices of earlier instructions, so every pass is a
+// linear walk over contiguous memory.
+namespace inf::mir {
+using Value = std::uint32_t;
+
+inline constexpr Value no_value = std::numeric_limits<Value>::max();
+
+enum class Opcode : std::uint8_t {
+    Constant,  // a: index into Module::constants
+    Parameter, // a: parameter number
+    Call,      // a: index into Module::functions
+    Negate,    // a
+    Add,       // a + b
+    Subtract,  // a - b
+    Multiply,  // a * b
+    Divide,    // a / b, exact; truncating at runtime
+    Modulo,    // a - b * trunc(a / b), sign of a
+};
+
+struct Instruction {
+    enum Flags : std::uint8_t {
+        None = 0,
+        // range analysis proved the result fits in 64 bits, so the
+        // operation needs no overflow check. a quotient or remainder is
+        // only exact when its operands cannot be INT64_MIN and -1.
+        Exact64 = 1 << 0,
+        // range analysis proved the divisor is never zero.
+        NonZeroDivisor = 1 << 1,
+    };
+
+    Opcode       opcode;
+    std::uint8_t flags;
+    Value        a;
+    Value        b;
+
+    bool has(Flags flag) const noexcept { return (flags & flag) != 0; }
+};
+
+inline bool is_binop(Opcode opcode) noexcept {
+    return opcode >= Opcode::Add;
+}
+
+inline bool is_commutative(Opcode opcode) noexcept {
+    return opcode == Opcode::Add || opcode == Opcode::Multiply;
+}
+
+struct Function {
+    Label         name;
+    SourceRange   range;
+    // entry functions are the module's observable results, as are exported
+    // bindings; every other function is a binding, private to the module.
+    bool          entry;
+    bool          exported;
+    std::uint32_t parameters;
+    Value         result;
+
+    std::vector<Instruction> instructions;
+    // parallel to instructions, for diagnostics and debug info.
+    std::vector<SourceRange> ranges;
+
+    Value append(Instruction instruction, SourceRange range) {
+        instructions.push_back(instruction);
+        ranges.push_back(range);
+        return static_cast<Value>(instructions.size() - 1);
+    }
+};
+
+struct Module {
+    // a binding may only call functions before it, so there are no cycles
+    // and walking functions in order visits callees before callers.
+    std::vector<Function> functions;
+    std::vector<Rational> constants;
+};
+} // namespace inf::mir
+
+#endif // !INF_IMR_MIR_HPP
@@ -25,6 +25,15 @@ using Integer = boost::multiprecision::mpz_int;
 using Real = boost::multiprecision::mpf_float;
 using Complex = boost::multiprecision::mpc_complex;
 using Rational = boost::multiprecision::mpq_rational;
+
+inline bool is_integer(Rational const &value) {
+    return denominator(value) == 1;
+}
+
+// the integer part of value, rounding toward zero.
+inline Integer truncate(Rational const &value) {
+    return Integer{numerator(value) / denominator(value)};
+}
 }
 
 #endif // !INF_IMR_NUMBER_HPP
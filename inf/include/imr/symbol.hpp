@@ -17,15 +17,111 @@
 #ifndef INF_IMR_SYMBOL_HPP
 #define INF_IMR_SYMBOL_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 #include "imr/label.hpp"
-#include "imr/type.hpp"
-#include "imr/value.hpp"
 
 namespace inf {
+// what a label names while lowering.
 struct Symbol {
-    Label label;
-    Type  type;
-    Value value;
+    enum class Kind : std::uint8_t { Binding, Parameter };
+
+    Kind          kind;
+    // the function computing a binding, or the position of a parameter.
+    std::uint32_t index;
+};
+
+// a stack of scopes in one open addressing table, keyed on the address of
+// interned labels. a symbol shadowing one in an outer scope overwrites it
+// in place, and the undo log restores it when the scope is popped, so
+// entering and leaving a scope costs nothing beyond the symbols bound in
+// it.
+class SymbolTable {
+    // packed into 16 bytes, four to a cache line.
+    struct Slot {
+        // the text of the interned label, nullptr when empty.
+        char const   *key;
+        std::uint32_t index;
+        // the scope which bound the symbol, above its kind.
+        std::uint32_t tag;
+
+        bool          empty() const noexcept { return key == nullptr; }
+        std::uint32_t depth() const noexcept { return tag >> 8; }
+        Symbol        symbol() const noexcept {
+            return {static_cast<Symbol::Kind>(tag & 0xff), index};
+        }
+    };
+
+    struct Undo {
+        char const *key;
+        // the slot before it was bound in the popped scope, empty if the
+        // label was unbound.
+        Slot        shadowed;
+    };
+
+    // a power of two in size, and never more than half full, so probe
+    // sequences stay short.
+    std::vector<Slot>        slots;
+    std::vector<Undo>        log;
+    // the size of log as each scope was pushed.
+    std::vector<std::size_t> marks;
+    std::size_t              count;
+    int                      shift;
+
+    // fibonacci hashing: the top bits of the product depend on every bit
+    // of the address. interned labels are allocated one after another, so
+    // once the alignment bits are dropped their addresses spread evenly.
+    std::size_t home(char const *key) const noexcept {
+        auto address = static_cast<std::uint64_t>(
+            reinterpret_cast<std::uintptr_t>(key));
+        return static_cast<std::size_t>(
+            ((address >> 3) * 0x9e3779b97f4a7c15ull) >> shift);
+    }
+
+    // the slot holding key, or the empty slot where it would go.
+    Slot *probe(char const *key) noexcept {
+        std::size_t mask = slots.size() - 1;
+        for (std::size_t index = home(key);; index = (index + 1) & mask) {
+            Slot &slot = slots[index];
+            if (slot.key == key || slot.empty()) { return &slot; }
+        }
+    }
+
+    Slot const *probe(char const *key) const noexcept {
+        return const_cast<SymbolTable *>(this)->probe(key);
+    }
+
+    void grow(std::size_t capacity);
+    void erase(char const *key) noexcept;
+
+  public:
+    SymbolTable() : slots(), log(), marks(), count(0), shift(0) { grow(16); }
+
+    // the innermost symbol named label.
+    std::optional<Symbol> find(Label label) const noexcept {
+        Slot const *slot = probe(label.data());
+        if (slot->empty()) { return std::nullopt; }
+        return slot->symbol();
+    }
+
+    // bind label to symbol in the innermost scope, shadowing any outer
+    // symbol of the same name. returns false if the innermost scope already
+    // bound label, in which case symbol replaces it.
+    bool bind(Label label, Symbol symbol);
+
+    void push();
+    // forget every symbol bound since the matching push, restoring those
+    // they shadowed.
+    void pop() noexcept;
+
+    // make room for size symbols without rehashing.
+    void reserve(std::size_t size);
+
+    std::size_t size() const noexcept { return count; }
+    std::size_t depth() const noexcept { return marks.size(); }
 };
 } // namespace inf
 
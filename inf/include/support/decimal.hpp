@@ -0,0 +1,32 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_SUPPORT_DECIMAL_HPP
+#define INF_SUPPORT_DECIMAL_HPP
+
+#include <string_view>
+
+#include "imr/number.hpp"
+
+namespace inf {
+// the value of a non-empty string of decimal digits, leading zeros and all.
+// up to 19 digits are decoded eight or sixteen at a time straight into a
+// machine word; longer strings are decoded 19 digits at a time into the
+// limbs of the result, never through gmp's general base conversion.
+Integer parse_integer(std::string_view digits);
+} // namespace inf
+
+#endif // !INF_SUPPORT_DECIMAL_HPP
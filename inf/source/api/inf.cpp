@@ -0,0 +1,110 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <vector>
+
+#include "api/inf.h"
+#include "api/jit.hpp"
+
+struct inf_expression {
+    inf::Expression           expression;
+    // NULL unless compiled checked.
+    inf::Expression::Checked *checked;
+};
+
+namespace {
+char *copy(char const *message) {
+    std::size_t length = std::strlen(message);
+    auto       *result = static_cast<char *>(std::malloc(length + 1));
+    if (result != nullptr) { std::memcpy(result, message, length + 1); }
+    return result;
+}
+} // namespace
+
+extern "C" {
+inf_jit_options inf_jit_options_default(void) {
+    inf::JitOptions defaults;
+    return {defaults.optimization_level,
+            defaults.round,
+            nullptr,
+            defaults.perf,
+            defaults.gdb,
+            defaults.checked};
+}
+
+inf_expression *inf_compile(char const            *source,
+                            char const *const     *parameters,
+                            size_t                 count,
+                            inf_jit_options const *options,
+                            char                 **error) {
+    try {
+        inf::JitOptions jit;
+        if (options != nullptr) {
+            jit.optimization_level = options->optimization_level;
+            jit.round              = options->round != 0;
+            jit.perf               = options->perf != 0;
+            jit.gdb                = options->gdb != 0;
+            jit.checked            = options->checked != 0;
+            if (options->name != nullptr) { jit.name = options->name; }
+        }
+        std::vector<std::string_view> names(parameters, parameters + count);
+
+        auto *result =
+            new inf_expression{inf::compile(source, names, jit), nullptr};
+        if (jit.checked && !result->expression.returns_double()) {
+            result->checked = result->expression.checked();
+        }
+        return result;
+    } catch (std::exception const &e) {
+        if (error != nullptr) { *error = copy(e.what()); }
+        return nullptr;
+    }
+}
+
+void *inf_expression_address(inf_expression const *expression) {
+    return expression->expression.address();
+}
+
+size_t inf_expression_arity(inf_expression const *expression) {
+    return expression->expression.arity();
+}
+
+int inf_expression_returns_double(inf_expression const *expression) {
+    return expression->expression.returns_double() ? 1 : 0;
+}
+
+inf_status inf_expression_evaluate(inf_expression const *expression,
+                                   int64_t const        *arguments,
+                                   int64_t              *result) {
+    if (expression->checked == nullptr) { return INF_UNCHECKED; }
+
+    std::int32_t fault = 0;
+    std::int64_t value = expression->checked(arguments, &fault);
+    if (fault != 0) { return INF_FAULT; }
+    *result = value;
+    return INF_OK;
+}
+
+void inf_expression_release(inf_expression *expression) { delete expression; }
+
+void inf_error_release(char *error) { std::free(error); }
+}
@@ -0,0 +1,521 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/ExecutionEngine/Orc/CompileOnDemandLayer.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "api/jit.hpp"
+#include "core/codegen.hpp"
+#include "core/emit.hpp"
+#include "core/interpret.hpp"
+#include "core/listeners.hpp"
+#include "core/lower.hpp"
+#include "core/optimize.hpp"
+#include "core/parser.hpp"
+#include "core/passes.hpp"
+#include "env/context.hpp"
+
+namespace inf {
+namespace {
+// llvm's target registration, and so constructing a Context, is not safe
+// to run concurrently.
+std::mutex compile_mutex;
+
+// every error recorded in context, one per line.
+Error diagnostics(Context const &context) {
+    std::ostringstream message;
+    for (Error const &error : context.errors()) {
+        context.sources().print(message, error.range());
+        message << ": " << error.message() << "\n";
+    }
+    return Error{std::move(message).str()};
+}
+
+// source with its final ';' supplied when left off.
+std::string terminate(std::string_view source) {
+    std::string text{source};
+    std::size_t last = source.find_last_not_of(" \t\n\v\f\r");
+    if (last == std::string_view::npos || source[last] != ';') {
+        text += ";";
+    }
+    return text;
+}
+
+// parse source into statements, throwing its diagnostics on failure.
+std::vector<Ast::Ptr> parse(Context &context, Location file) {
+    std::vector<Ast::Ptr> statements;
+    yy::Lexer             lexer{&context};
+    lexer.set_view(context.sources().text(file), file);
+    yy::Parser parser{&lexer, &context, &statements};
+    if (parser.parse() != 0 && context.errors().empty()) {
+        context.error({"syntax error", {file, file}});
+    }
+    if (!context.errors().empty()) { throw diagnostics(context); }
+    return statements;
+}
+
+// source lowered as an expression of parameters, with its MIR optimized.
+// throws the diagnostics unless it holds exactly one expression.
+mir::Module lower_expression(Context                          &context,
+                             std::string_view                  source,
+                             std::span<std::string_view const> parameters,
+                             std::string_view                  name) {
+    Location           file = context.sources().add(name, terminate(source));
+    std::vector<Label> labels;
+    for (std::string_view parameter : parameters) {
+        labels.push_back(context.intern_string(
+            llvm::StringRef{parameter.data(), parameter.size()}));
+    }
+
+    std::vector<Ast::Ptr> statements = parse(context, file);
+    mir::Module           module     = lower(context, statements, labels);
+    statements.clear();
+
+    std::size_t entries = 0;
+    for (mir::Function const &function : module.functions) {
+        if (function.entry) { ++entries; }
+    }
+    if (entries != 1) {
+        context.error({"expected a single expression, found " +
+                           std::to_string(entries),
+                       {file, file}});
+    }
+    if (!context.errors().empty()) { throw diagnostics(context); }
+
+    mir::optimize(module);
+    return module;
+}
+
+// entry taking its arguments from an array instead, for callers which only
+// know its arity at runtime. a checked entry's fault is passed on, cleared.
+llvm::Function *pack(Context &context, llvm::Function *entry, bool checked) {
+    llvm::IRBuilder<>        &builder = context.builder();
+    llvm::Type               *i64     = builder.getInt64Ty();
+    std::vector<llvm::Type *> parameters(checked ? 2 : 1, builder.getPtrTy());
+    llvm::FunctionType       *type    = llvm::FunctionType::get(
+        i64, parameters, /* isVarArg = */ false);
+    llvm::Function *packed =
+        llvm::Function::Create(type,
+                               llvm::Function::ExternalLinkage,
+                               entry->getName() +
+                                   (checked ? ".checked" : ".packed"),
+                               context.module());
+    packed->setDoesNotThrow();
+    builder.SetInsertPoint(
+        llvm::BasicBlock::Create(context.ir_context(), "entry", packed));
+    builder.SetCurrentDebugLocation({});
+
+    std::vector<llvm::Value *> arguments;
+    std::size_t                arity = entry->arg_size() - (checked ? 1 : 0);
+    for (unsigned index = 0; index < arity; ++index) {
+        arguments.push_back(builder.CreateLoad(
+            i64,
+            builder.CreateConstInBoundsGEP1_32(
+                i64, packed->getArg(0), index)));
+    }
+    if (checked) {
+        builder.CreateStore(builder.getInt32(0), packed->getArg(1));
+        arguments.push_back(packed->getArg(1));
+    }
+    builder.CreateRet(builder.CreateCall(entry, arguments));
+    return packed;
+}
+
+// the jit's own copy of the context's module, which it needs to own
+// together with the LLVMContext it lives in.
+llvm::orc::ThreadSafeModule copy_module(Context &context) {
+    llvm::SmallVector<char, 0> bitcode;
+    llvm::raw_svector_ostream  stream{bitcode};
+    llvm::WriteBitcodeToFile(context.module(), stream);
+
+    auto ir_context = std::make_unique<llvm::LLVMContext>();
+    auto module     = llvm::parseBitcodeFile(
+        llvm::MemoryBufferRef{llvm::StringRef{bitcode.data(), bitcode.size()},
+                              context.module().getModuleIdentifier()},
+        *ir_context);
+    if (!module) { throw Error{llvm::toString(module.takeError())}; }
+    return llvm::orc::ThreadSafeModule{std::move(*module),
+                                       std::move(ir_context)};
+}
+
+// optimizes each function as it is compiled. the machine is shared by
+// whichever threads happen to call uncompiled functions at once.
+struct LazyOptimizer {
+    std::mutex                           mutex;
+    std::unique_ptr<llvm::TargetMachine> target_machine;
+    unsigned                             level;
+
+    void run(llvm::Module &module) {
+        std::lock_guard<std::mutex> lock{mutex};
+        optimize(module, target_machine.get(), level);
+    }
+};
+
+// where a stub jumps when its function fails to compile, after the
+// failure has been reported.
+[[noreturn]] void lazy_compile_failed() { std::abort(); }
+} // namespace
+
+Expression::Expression(std::unique_ptr<llvm::orc::LLJIT> jit,
+                       void                             *address,
+                       Packed                           *packed,
+                       Checked                          *checked,
+                       std::size_t                       arity,
+                       bool returns_double) noexcept
+    : m_jit(std::move(jit)), m_address(address), m_packed(packed),
+      m_checked(checked), m_arity(arity), m_returns_double(returns_double) {}
+
+Expression::Expression(Expression &&other) noexcept            = default;
+Expression &Expression::operator=(Expression &&other) noexcept = default;
+Expression::~Expression()                                      = default;
+
+void Expression::check(std::size_t arity, bool returns_double) const {
+    if (m_checked != nullptr) {
+        throw Error{"expression is checked, so is called through checked()"};
+    }
+    if (arity != m_arity) {
+        throw Error{"expression takes " + std::to_string(m_arity) +
+                    " parameters, not " + std::to_string(arity)};
+    }
+    if (returns_double != m_returns_double) {
+        throw Error{std::string{"expression returns "} +
+                    (m_returns_double ? "a double" : "an std::int64_t")};
+    }
+}
+
+Expression::Packed *Expression::packed() const {
+    if (m_returns_double) { throw Error{"expression returns a double"}; }
+    if (m_checked != nullptr) {
+        throw Error{"expression is checked, so is called through checked()"};
+    }
+    return m_packed;
+}
+
+Expression::Checked *Expression::checked() const {
+    if (m_returns_double) { throw Error{"expression returns a double"}; }
+    if (m_checked == nullptr) { throw Error{"expression is not checked"}; }
+    return m_checked;
+}
+
+Expression compile(std::string_view                   source,
+                   std::span<std::string_view const> parameters,
+                   JitOptions                         options) {
+    std::lock_guard<std::mutex> lock{compile_mutex};
+
+    JitListeners listeners = JitListeners::from_environment();
+    listeners.perf         = listeners.perf || options.perf;
+    listeners.gdb          = listeners.gdb || options.gdb;
+
+    Context     context{"expression"};
+    mir::Module module =
+        lower_expression(context, source, parameters, options.name);
+    auto entry = std::ranges::find_if(
+        module.functions, [](mir::Function const &f) { return f.entry; });
+    Label name = entry->name;
+    codegen(context,
+            module,
+            {.round      = options.round,
+             .debug_info = listeners.any(),
+             .checked    = options.checked});
+    if (!context.errors().empty()) { throw diagnostics(context); }
+
+    llvm::Function *entry_function = context.module().getFunction(name);
+    bool            returns_double =
+        entry_function->getReturnType()->isDoubleTy();
+    llvm::Function *packed =
+        returns_double ? nullptr
+                       : pack(context, entry_function, options.checked);
+    if (listeners.any()) { name_by_location(context, module); }
+    std::string symbol_name = entry_function->getName().str();
+
+    optimize(context, options.optimization_level);
+    std::vector<ObjectBuffer> objects = emit_objects(context, 1);
+
+    llvm::orc::LLJITBuilder builder;
+    if (listeners.any()) {
+        builder.setObjectLinkingLayerCreator(
+            [listeners](llvm::orc::ExecutionSession &session, auto const &...) {
+                return listening_layer(session, listeners);
+            });
+    }
+    auto jit = builder.create();
+    if (!jit) { throw Error{llvm::toString(jit.takeError())}; }
+
+    ObjectBuffer const &object = objects.front();
+    if (llvm::Error error = (*jit)->addObjectFile(
+            llvm::MemoryBuffer::getMemBufferCopy(
+                llvm::StringRef{object.data(), object.size()},
+                symbol_name))) {
+        throw Error{llvm::toString(std::move(error))};
+    }
+
+    auto symbol = (*jit)->lookup(symbol_name);
+    if (!symbol) { throw Error{llvm::toString(symbol.takeError())}; }
+    Expression::Packed  *packed_address  = nullptr;
+    Expression::Checked *checked_address = nullptr;
+    if (packed != nullptr) {
+        auto packed_symbol = (*jit)->lookup(packed->getName());
+        if (!packed_symbol) {
+            throw Error{llvm::toString(packed_symbol.takeError())};
+        }
+        if (options.checked) {
+            checked_address = packed_symbol->toPtr<Expression::Checked *>();
+        } else {
+            packed_address = packed_symbol->toPtr<Expression::Packed *>();
+        }
+    }
+
+    return Expression{std::move(*jit),
+                      symbol->toPtr<void *>(),
+                      packed_address,
+                      checked_address,
+                      parameters.size(),
+                      returns_double};
+}
+
+struct Tiered::State {
+    std::string                       source;
+    std::vector<std::string>          parameters;
+    std::string                       name;
+    JitOptions                        options;
+    bytecode::Program                 program;
+    std::uint64_t                     promote_after;
+    std::atomic<std::uint64_t>        evaluations;
+    std::optional<Expression>         expression;
+    std::atomic<Expression::Packed *> native;
+    // last, so that it is joined before what it writes is destroyed.
+    std::jthread                      compiler;
+
+    // whether there is anything for native code to speed up.
+    bool constant() const noexcept {
+        return program.returns_double ||
+               program.functions[program.entry].instructions.size() == 1;
+    }
+
+    void promote() {
+        compiler = std::jthread{[this]() {
+            std::vector<std::string_view> names{parameters.begin(),
+                                                parameters.end()};
+            options.name = name;
+            try {
+                expression.emplace(compile(source, names, options));
+                native.store(expression->packed(), std::memory_order_release);
+            } catch (Error const &) {
+                // the source has compiled to bytecode, so this is LLVM
+                // failing; evaluations carry on interpreted.
+            }
+        }};
+    }
+};
+
+Tiered::Tiered(std::unique_ptr<State> state) noexcept
+    : m_state(std::move(state)) {}
+
+Tiered::Tiered(Tiered &&other) noexcept            = default;
+Tiered &Tiered::operator=(Tiered &&other) noexcept = default;
+Tiered::~Tiered()                                  = default;
+
+std::size_t Tiered::arity() const noexcept {
+    return m_state->parameters.size();
+}
+
+bool Tiered::returns_double() const noexcept {
+    return m_state->program.returns_double;
+}
+
+double Tiered::real() const {
+    if (!m_state->program.returns_double) {
+        throw Error{"expression returns an std::int64_t"};
+    }
+    return m_state->program.real;
+}
+
+bool Tiered::native() const noexcept {
+    return m_state->native.load(std::memory_order_acquire) != nullptr;
+}
+
+std::int64_t Tiered::evaluate(std::span<std::int64_t const> arguments) const {
+    State &state = *m_state;
+    if (arguments.size() != state.parameters.size()) {
+        throw Error{"expression takes " +
+                    std::to_string(state.parameters.size()) +
+                    " parameters, not " + std::to_string(arguments.size())};
+    }
+    if (Expression::Packed *native =
+            state.native.load(std::memory_order_acquire)) {
+        return native(arguments.data());
+    }
+    // exactly one evaluation sees the count reach the threshold.
+    if (state.evaluations.fetch_add(1, std::memory_order_relaxed) + 1 ==
+            state.promote_after &&
+        !state.constant()) {
+        state.promote();
+    }
+    return interpret(state.program, arguments);
+}
+
+Tiered prepare(std::string_view                   source,
+               std::span<std::string_view const> parameters,
+               TierOptions                        options) {
+    auto state           = std::make_unique<Tiered::State>();
+    state->source        = source;
+    state->parameters    = {parameters.begin(), parameters.end()};
+    state->name          = options.jit.name;
+    state->options       = options.jit;
+    state->promote_after = options.promote_after;
+    // native code is called through Expression::packed.
+    state->options.checked = false;
+    {
+        std::lock_guard<std::mutex> lock{compile_mutex};
+
+        Context     context{"expression"};
+        mir::Module module =
+            lower_expression(context, source, parameters, state->name);
+        state->program = assemble(context, module, options.jit.round);
+        if (!context.errors().empty()) { throw diagnostics(context); }
+    }
+
+    if (state->promote_after == 0 && !state->constant()) { state->promote(); }
+    return Tiered{std::move(state)};
+}
+
+Library::Library(std::unique_ptr<llvm::orc::LLLazyJIT>        jit,
+                 std::unordered_map<std::string, std::string> symbols) noexcept
+    : m_jit(std::move(jit)), m_symbols(std::move(symbols)) {}
+
+Library::Library(Library &&other) noexcept            = default;
+Library &Library::operator=(Library &&other) noexcept = default;
+Library::~Library()                                   = default;
+
+bool Library::contains(std::string_view name) const {
+    return m_symbols.contains(std::string{name});
+}
+
+Library::Function *Library::function(std::string_view name) const {
+    auto found = m_symbols.find(std::string{name});
+    if (found == m_symbols.end()) {
+        throw Error{"unknown binding: " + std::string{name}};
+    }
+    // the stub, which compiles the function when first called.
+    auto symbol = m_jit->lookup(found->second);
+    if (!symbol) { throw Error{llvm::toString(symbol.takeError())}; }
+    return symbol->toPtr<Function *>();
+}
+
+Library load(std::string_view source, JitOptions options) {
+    std::lock_guard<std::mutex> lock{compile_mutex};
+
+    JitListeners listeners = JitListeners::from_environment();
+    listeners.perf         = listeners.perf || options.perf;
+    listeners.gdb          = listeners.gdb || options.gdb;
+
+    Context               context{"library"};
+    Location              file = context.sources().add(options.name,
+                                                       terminate(source));
+    std::vector<Ast::Ptr> statements = parse(context, file);
+
+    // every binding is exported, so the last of each label keeps it as its
+    // name and a function of its own.
+    std::vector<Label> exports;
+    for (Ast::Ptr const &statement : statements) {
+        if (statement->is<Ast::Binding>()) {
+            exports.push_back(statement->as<Ast::Binding>().label);
+        } else {
+            context.error({"a library holds bindings alone",
+                           statement->location()});
+        }
+    }
+    mir::Module module = lower(context, statements, {}, exports);
+    statements.clear();
+    if (!context.errors().empty()) { throw diagnostics(context); }
+
+    mir::optimize(module);
+    codegen(context,
+            module,
+            {.round = options.round, .debug_info = listeners.any()});
+    if (!context.errors().empty()) { throw diagnostics(context); }
+
+    std::vector<std::pair<Label, llvm::Function *>> functions;
+    for (mir::Function const &function : module.functions) {
+        if (function.exported) {
+            functions.emplace_back(
+                function.name, context.module().getFunction(function.name));
+        }
+    }
+    if (listeners.any()) { name_by_location(context, module); }
+    std::unordered_map<std::string, std::string> symbols;
+    for (auto [label, function] : functions) {
+        symbols.emplace(label.str(), function->getName().str());
+    }
+
+    auto target = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if (!target) { throw Error{llvm::toString(target.takeError())}; }
+    auto target_machine = target->createTargetMachine();
+    if (!target_machine) {
+        throw Error{llvm::toString(target_machine.takeError())};
+    }
+    auto optimizer = std::make_shared<LazyOptimizer>();
+    optimizer->target_machine = std::move(*target_machine);
+    optimizer->level          = options.optimization_level;
+
+    llvm::orc::LLLazyJITBuilder builder;
+    builder.setJITTargetMachineBuilder(std::move(*target));
+    builder.setLazyCompileFailureAddr(
+        llvm::orc::ExecutorAddr::fromPtr(&lazy_compile_failed));
+    if (listeners.any()) {
+        builder.setObjectLinkingLayerCreator(
+            [listeners](llvm::orc::ExecutionSession &session, auto const &...) {
+                return listening_layer(session, listeners);
+            });
+    }
+    auto jit = builder.create();
+    if (!jit) { throw Error{llvm::toString(jit.takeError())}; }
+
+    // each function is split into a module of its own, and optimized on
+    // its own, when first called. that loses inlining across bindings,
+    // which compile keeps, for paying only for what is called.
+    (*jit)->setPartitionFunction(
+        llvm::orc::CompileOnDemandLayer::compileRequested);
+    (*jit)->getIRTransformLayer().setTransform(
+        [optimizer](llvm::orc::ThreadSafeModule module,
+                    llvm::orc::MaterializationResponsibility const &)
+            -> llvm::Expected<llvm::orc::ThreadSafeModule> {
+            module.withModuleDo(
+                [&](llvm::Module &ir) { optimizer->run(ir); });
+            return module;
+        });
+
+    if (llvm::Error error = (*jit)->addLazyIRModule(copy_module(context))) {
+        throw Error{llvm::toString(std::move(error))};
+    }
+    return Library{std::move(*jit), std::move(symbols)};
+}
+} // namespace inf
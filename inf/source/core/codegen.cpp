@@ -0,0 +1,431 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <limits>
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DIBuilder.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/Support/Path.h"
+
+#include "core/codegen.hpp"
+
+namespace inf {
+std::int64_t integer_constant(Context        &context,
+                              Rational const &value,
+                              SourceRange     range,
+                              bool            round) {
+    // checked here rather than trusting Exact64, which is only set when the
+    // MIR passes ran.
+    if (!is_integer(value) && !round) {
+        context.error({"constant is not an integer: " + value.str() +
+                           " (use --round to truncate it)",
+                       range});
+        return 0;
+    }
+
+    Integer integer = truncate(value);
+    if (integer < std::numeric_limits<std::int64_t>::min() ||
+        integer > std::numeric_limits<std::int64_t>::max()) {
+        context.error(
+            {"integer constant does not fit in 64 bits: " + integer.str(),
+             range});
+        return 0;
+    }
+    return integer.convert_to<std::int64_t>();
+}
+
+double real_constant(Context        &context,
+                     Rational const &value,
+                     SourceRange     range,
+                     bool            round) {
+    auto real = value.convert_to<double>();
+    if (Rational{real} != value && !round) {
+        context.error({"constant is not exactly representable as a double: " +
+                           value.str() + " (use --round to round it)",
+                       range});
+    }
+    return real;
+}
+
+bool returns_double(mir::Module const   &module,
+                    mir::Function const &function) {
+    if (!function.entry) { return false; }
+    mir::Instruction const &result = function.instructions[function.result];
+    return result.opcode == mir::Opcode::Constant &&
+           !is_integer(module.constants[result.a]);
+}
+
+void check_division(Context                &context,
+                    mir::Module const      &module,
+                    mir::Function const    &function,
+                    mir::Instruction const &instruction,
+                    SourceRange             range,
+                    bool                    round) {
+    if (instruction.opcode != mir::Opcode::Divide &&
+        instruction.opcode != mir::Opcode::Modulo) {
+        return;
+    }
+
+    mir::Instruction const &divisor = function.instructions[instruction.b];
+    if (divisor.opcode == mir::Opcode::Constant &&
+        module.constants[divisor.a].is_zero()) {
+        context.error({"division by zero", range});
+        return;
+    }
+
+    // a quotient of runtime integers is generally not an integer, so
+    // truncating it is rounding the user must ask for.
+    if (instruction.opcode == mir::Opcode::Divide && !round) {
+        context.error({"division is not constant, so its result would be "
+                       "truncated (use --round to allow it)",
+                       range});
+    }
+}
+
+namespace {
+class Codegen {
+    Context                      *context;
+    mir::Module const            *module;
+    CodegenOptions                options;
+    llvm::IRBuilder<>            *builder;
+    llvm::Type                   *i64;
+    std::vector<llvm::Function *> functions;
+
+    llvm::Function   *function;
+    llvm::BasicBlock *trap;
+
+    // only built when options.debug_info is set.
+    std::unique_ptr<llvm::DIBuilder> debug;
+    llvm::StringMap<llvm::DIFile *>  files;
+    llvm::DISubroutineType          *subroutine;
+    llvm::DISubprogram              *subprogram;
+
+    llvm::DIFile *debug_file(llvm::StringRef name) {
+        llvm::DIFile *&file = files[name];
+        if (file == nullptr) {
+            file = debug->createFile(llvm::sys::path::filename(name),
+                                     llvm::sys::path::parent_path(name));
+        }
+        return file;
+    }
+
+    void begin_debug_info() {
+        llvm::Module &llvm_module = context->module();
+        llvm_module.addModuleFlag(llvm::Module::Warning,
+                                  "Debug Info Version",
+                                  llvm::DEBUG_METADATA_VERSION);
+        llvm_module.addModuleFlag(llvm::Module::Warning, "Dwarf Version", 5);
+
+        debug = std::make_unique<llvm::DIBuilder>(llvm_module);
+        debug->createCompileUnit(
+            llvm::dwarf::DW_LANG_C,
+            debug_file(llvm_module.getModuleIdentifier()),
+            "inf",
+            /* isOptimized = */ true,
+            /* Flags = */ "",
+            /* RV = */ 0);
+        subroutine =
+            debug->createSubroutineType(debug->getOrCreateTypeArray({}));
+    }
+
+    // give function a subprogram starting at its statement.
+    void describe(mir::Function const &mir_function) {
+        if (!debug) { return; }
+
+        SourceManager::Presumed where =
+            context->sources().presume(mir_function.range.begin);
+        llvm::DIFile *file = debug_file(where.file);
+        subprogram         = debug->createFunction(
+            file,
+            mir_function.name,
+            function->getName(),
+            file,
+            where.line,
+            subroutine,
+            where.line,
+            llvm::DINode::FlagPrototyped,
+            llvm::DISubprogram::SPFlagDefinition |
+                llvm::DISubprogram::SPFlagOptimized);
+        function->setSubprogram(subprogram);
+    }
+
+    // attribute the instructions built from here on to range.
+    void locate(SourceRange range) {
+        if (!debug) { return; }
+
+        SourceManager::Presumed where =
+            context->sources().presume(range.begin);
+        builder->SetCurrentDebugLocation(llvm::DILocation::get(
+            context->ir_context(), where.line, where.column, subprogram));
+    }
+
+    // where a checked function reports a fault.
+    llvm::Value *fault() const {
+        return function->getArg(
+            static_cast<unsigned>(function->arg_size() - 1));
+    }
+
+    llvm::BasicBlock *trap_block() {
+        if (trap != nullptr) { return trap; }
+
+        llvm::BasicBlock *current = builder->GetInsertBlock();
+        trap =
+            llvm::BasicBlock::Create(context->ir_context(), "trap", function);
+        builder->SetInsertPoint(trap);
+        if (options.checked) {
+            builder->CreateStore(builder->getInt32(1), fault());
+            builder->CreateRet(builder->getInt64(0));
+        } else {
+            builder->CreateIntrinsic(llvm::Intrinsic::trap, {}, {});
+            builder->CreateUnreachable();
+        }
+        builder->SetInsertPoint(current);
+        return trap;
+    }
+
+    // branch to the trap block when condition holds.
+    void trap_if(llvm::Value *condition) {
+        llvm::BasicBlock *next = llvm::BasicBlock::Create(
+            context->ir_context(), "checked", function);
+        builder->CreateCondBr(condition, trap_block(), next);
+        builder->SetInsertPoint(next);
+    }
+
+    llvm::Value *
+    checked(llvm::Intrinsic::ID id, llvm::Value *a, llvm::Value *b) {
+        llvm::Value *pair = builder->CreateBinaryIntrinsic(id, a, b);
+        trap_if(builder->CreateExtractValue(pair, 1));
+        return builder->CreateExtractValue(pair, 0);
+    }
+
+    llvm::Value *constant(mir::Instruction const &instruction,
+                          SourceRange             range) {
+        return builder->getInt64(static_cast<std::uint64_t>(integer_constant(
+            *context, module->constants[instruction.a], range, options.round)));
+    }
+
+    bool returns_double(mir::Function const &mir_function) const {
+        return inf::returns_double(*module, mir_function);
+    }
+
+    llvm::Value *real(mir::Instruction const &instruction, SourceRange range) {
+        return llvm::ConstantFP::get(
+            builder->getDoubleTy(),
+            real_constant(*context,
+                          module->constants[instruction.a],
+                          range,
+                          options.round));
+    }
+
+    llvm::Value *divide(mir::Function const    &mir_function,
+                        mir::Instruction const &instruction,
+                        SourceRange             range,
+                        llvm::Value            *a,
+                        llvm::Value            *b) {
+        check_division(*context,
+                       *module,
+                       mir_function,
+                       instruction,
+                       range,
+                       options.round);
+        if (!instruction.has(mir::Instruction::NonZeroDivisor)) {
+            trap_if(builder->CreateICmpEQ(b, builder->getInt64(0)));
+        }
+        if (instruction.has(mir::Instruction::Exact64)) {
+            return instruction.opcode == mir::Opcode::Divide
+                       ? builder->CreateSDiv(a, b)
+                       : builder->CreateSRem(a, b);
+        }
+
+        llvm::Value *minus_one = llvm::ConstantInt::getSigned(i64, -1);
+        if (instruction.opcode == mir::Opcode::Modulo) {
+            // every remainder by -1 is 0, as by 1, which cannot fault on
+            // INT64_MIN as srem by -1 does.
+            return builder->CreateSRem(
+                a,
+                builder->CreateSelect(builder->CreateICmpEQ(b, minus_one),
+                                      builder->getInt64(1),
+                                      b));
+        }
+        // INT64_MIN / -1 is the one quotient which does not fit.
+        auto min = std::numeric_limits<std::int64_t>::min();
+        trap_if(builder->CreateAnd(
+            builder->CreateICmpEQ(
+                a, builder->getInt64(static_cast<std::uint64_t>(min))),
+            builder->CreateICmpEQ(b, minus_one)));
+        return builder->CreateSDiv(a, b);
+    }
+
+    void declare(mir::Function const &mir_function) {
+        std::vector<llvm::Type *> parameters(mir_function.parameters, i64);
+        llvm::Type *result = returns_double(mir_function)
+                                 ? builder->getDoubleTy()
+                                 : i64;
+        if (options.checked && result == i64) {
+            parameters.push_back(builder->getPtrTy());
+        }
+        llvm::FunctionType *type = llvm::FunctionType::get(
+            result, parameters, /* isVarArg = */ false);
+        // an exported binding is found by its label, so a binding it shadows
+        // gives the name up rather than the export being renamed.
+        if (mir_function.exported) {
+            if (llvm::Function *shadowed =
+                    context->module().getFunction(mir_function.name)) {
+                shadowed->setName(mir_function.name.str() + ".shadowed");
+            }
+        }
+        llvm::Function *llvm_function = llvm::Function::Create(
+            type,
+            mir_function.entry || mir_function.exported
+                ? llvm::Function::ExternalLinkage
+                : llvm::Function::InternalLinkage,
+            mir_function.name,
+            context->module());
+        llvm_function->setDoesNotThrow();
+        functions.push_back(llvm_function);
+    }
+
+    void define(mir::Function const &mir_function, llvm::Function *target) {
+        function = target;
+        trap     = nullptr;
+        builder->SetInsertPoint(
+            llvm::BasicBlock::Create(context->ir_context(), "entry", function));
+        describe(mir_function);
+        locate(mir_function.range);
+
+        if (returns_double(mir_function)) {
+            // the rest of the function is pure and unused.
+            builder->CreateRet(
+                real(mir_function.instructions[mir_function.result],
+                     mir_function.ranges[mir_function.result]));
+            return;
+        }
+
+        std::vector<llvm::Value *> values;
+        values.reserve(mir_function.instructions.size());
+        for (std::size_t index = 0; index < mir_function.instructions.size();
+             ++index) {
+            mir::Instruction const &instruction =
+                mir_function.instructions[index];
+            bool         exact = instruction.has(mir::Instruction::Exact64);
+            llvm::Value *a     = nullptr;
+            llvm::Value *b     = nullptr;
+            if (instruction.opcode == mir::Opcode::Negate) {
+                a = values[instruction.a];
+            } else if (mir::is_binop(instruction.opcode)) {
+                a = values[instruction.a];
+                b = values[instruction.b];
+            }
+
+            locate(mir_function.ranges[index]);
+            llvm::Value *value = nullptr;
+            switch (instruction.opcode) {
+            case mir::Opcode::Constant:
+                value = constant(instruction, mir_function.ranges[index]);
+                break;
+            case mir::Opcode::Parameter:
+                value = function->getArg(instruction.a);
+                break;
+            case mir::Opcode::Call:
+                if (!options.checked) {
+                    value = builder->CreateCall(functions[instruction.a]);
+                    break;
+                }
+                // the value of a call which faulted is never used, so the
+                // ranges the callee was analyzed with still hold.
+                value =
+                    builder->CreateCall(functions[instruction.a], {fault()});
+                trap_if(builder->CreateICmpNE(
+                    builder->CreateLoad(builder->getInt32Ty(), fault()),
+                    builder->getInt32(0)));
+                break;
+            case mir::Opcode::Negate:
+                value = exact ? builder->CreateNSWNeg(a)
+                              : checked(llvm::Intrinsic::ssub_with_overflow,
+                                        builder->getInt64(0),
+                                        a);
+                break;
+            case mir::Opcode::Add:
+                value = exact ? builder->CreateNSWAdd(a, b)
+                              : checked(llvm::Intrinsic::sadd_with_overflow,
+                                        a,
+                                        b);
+                break;
+            case mir::Opcode::Subtract:
+                value = exact ? builder->CreateNSWSub(a, b)
+                              : checked(llvm::Intrinsic::ssub_with_overflow,
+                                        a,
+                                        b);
+                break;
+            case mir::Opcode::Multiply:
+                value = exact ? builder->CreateNSWMul(a, b)
+                              : checked(llvm::Intrinsic::smul_with_overflow,
+                                        a,
+                                        b);
+                break;
+            case mir::Opcode::Divide:
+            case mir::Opcode::Modulo:
+                value = divide(mir_function,
+                               instruction,
+                               mir_function.ranges[index],
+                               a,
+                               b);
+                break;
+            default: throw Error::current("unknown mir opcode");
+            }
+            values.push_back(value);
+        }
+
+        builder->CreateRet(values[mir_function.result]);
+    }
+
+  public:
+    Codegen(Context               &context,
+            mir::Module const     &module,
+            CodegenOptions const &options)
+        : context(&context), module(&module), options(options),
+          builder(&context.builder()),
+          i64(context.builder().getInt64Ty()), functions(),
+          function(nullptr), trap(nullptr), debug(), files(),
+          subroutine(nullptr), subprogram(nullptr) {}
+
+    void run() {
+        if (options.debug_info) { begin_debug_info(); }
+
+        functions.reserve(module->functions.size());
+        for (mir::Function const &mir_function : module->functions) {
+            declare(mir_function);
+        }
+        for (std::size_t index = 0; index < functions.size(); ++index) {
+            define(module->functions[index], functions[index]);
+        }
+
+        builder->SetCurrentDebugLocation({});
+        if (debug) { debug->finalize(); }
+    }
+};
+} // namespace
+
+void codegen(Context              &context,
+             mir::Module const    &module,
+             CodegenOptions const &options) {
+    Codegen{context, module, options}.run();
+}
+} // namespace inf
@@ -0,0 +1,91 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstring>
+
+#include "llvm/CodeGen/ParallelCG.h"
+#include "llvm/IR/LegacyPassManager.h"
+#include "llvm/Support/FileOutputBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "core/emit.hpp"
+
+namespace inf {
+std::vector<ObjectBuffer> emit_objects(Context &context, unsigned partitions) {
+    if (partitions == 0) { partitions = 1; }
+
+    std::vector<ObjectBuffer>                               objects(partitions);
+    std::vector<std::unique_ptr<llvm::raw_svector_ostream>> streams;
+    llvm::SmallVector<llvm::raw_pwrite_stream *, 8>         outputs;
+    for (auto &object : objects) {
+        streams.emplace_back(
+            std::make_unique<llvm::raw_svector_ostream>(object));
+        outputs.push_back(streams.back().get());
+    }
+
+    if (partitions == 1) {
+        llvm::legacy::PassManager pass_manager;
+        if (context.target_machine().addPassesToEmitFile(
+                pass_manager,
+                *outputs.front(),
+                nullptr,
+                llvm::CodeGenFileType::ObjectFile)) {
+            throw Error::current("target cannot emit object files");
+        }
+        pass_manager.run(context.module());
+        return objects;
+    }
+
+    llvm::splitCodeGen(
+        context.module(),
+        outputs,
+        {},
+        [&context]() { return context.create_target_machine(); },
+        llvm::CodeGenFileType::ObjectFile);
+    return objects;
+}
+
+std::string object_path(std::string_view path, std::size_t index) {
+    if (index == 0) { return std::string{path}; }
+
+    llvm::SmallString<256> result{path};
+    llvm::StringRef        extension = llvm::sys::path::extension(path);
+    llvm::sys::path::replace_extension(result,
+                                       "." + std::to_string(index) +
+                                           extension.str());
+    return std::string{result};
+}
+
+void write_objects(std::string_view                path,
+                   std::span<ObjectBuffer const> objects) {
+    for (std::size_t index = 0; index < objects.size(); ++index) {
+        ObjectBuffer const &object = objects[index];
+        std::string         file   = object_path(path, index);
+
+        auto buffer = llvm::FileOutputBuffer::create(file, object.size());
+        if (!buffer) {
+            throw Error::current(llvm::toString(buffer.takeError()));
+        }
+
+        std::memcpy((*buffer)->getBufferStart(), object.data(), object.size());
+        if (llvm::Error error = (*buffer)->commit()) {
+            throw Error::current(llvm::toString(std::move(error)));
+        }
+    }
+}
+} // namespace inf
@@ -0,0 +1,252 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "core/codegen.hpp"
+#include "core/interpret.hpp"
+
+namespace inf {
+namespace {
+using bytecode::Opcode;
+
+Opcode opcode_of(mir::Instruction const &instruction) {
+    // Exact64 already excludes INT64_MIN / -1, so an exact quotient only
+    // needs its divisor to be non-zero as well.
+    bool exact   = instruction.has(mir::Instruction::Exact64);
+    bool nonzero = instruction.has(mir::Instruction::NonZeroDivisor);
+    switch (instruction.opcode) {
+    case mir::Opcode::Call:     return Opcode::Call;
+    case mir::Opcode::Negate:   return exact ? Opcode::NegateExact
+                                             : Opcode::Negate;
+    case mir::Opcode::Add:      return exact ? Opcode::AddExact : Opcode::Add;
+    case mir::Opcode::Subtract: return exact ? Opcode::SubtractExact
+                                             : Opcode::Subtract;
+    case mir::Opcode::Multiply: return exact ? Opcode::MultiplyExact
+                                             : Opcode::Multiply;
+    case mir::Opcode::Divide:   return exact && nonzero ? Opcode::DivideExact
+                                                        : Opcode::Divide;
+    case mir::Opcode::Modulo:   return exact && nonzero ? Opcode::ModuloExact
+                                                        : Opcode::Modulo;
+    default: throw Error::current("unknown mir opcode");
+    }
+}
+
+bytecode::Function assemble(Context             &context,
+                            mir::Module const   &module,
+                            mir::Function const &mir_function,
+                            bool                 round) {
+    bytecode::Function function{};
+    function.parameters = mir_function.parameters;
+
+    // parameters and constants are loaded before the first instruction
+    // runs, so they are numbered first.
+    std::size_t                size = mir_function.instructions.size();
+    std::vector<std::uint32_t> registers(size, 0);
+    for (std::size_t index = 0; index < size; ++index) {
+        mir::Instruction const &instruction = mir_function.instructions[index];
+        if (instruction.opcode == mir::Opcode::Parameter) {
+            registers[index] = instruction.a;
+        } else if (instruction.opcode == mir::Opcode::Constant) {
+            registers[index] = static_cast<std::uint32_t>(
+                function.parameters + function.constants.size());
+            function.constants.push_back(
+                integer_constant(context,
+                                 module.constants[instruction.a],
+                                 mir_function.ranges[index],
+                                 round));
+        }
+    }
+
+    auto next = static_cast<std::uint32_t>(function.parameters +
+                                           function.constants.size());
+    function.instructions.reserve(size + 1);
+    for (std::size_t index = 0; index < size; ++index) {
+        mir::Instruction const &instruction = mir_function.instructions[index];
+        if (instruction.opcode == mir::Opcode::Parameter ||
+            instruction.opcode == mir::Opcode::Constant) {
+            continue;
+        }
+
+        registers[index] = next++;
+        bytecode::Instruction code{
+            opcode_of(instruction), registers[index], 0, 0};
+        if (instruction.opcode == mir::Opcode::Call) {
+            code.a = instruction.a;
+        } else if (instruction.opcode == mir::Opcode::Negate) {
+            code.a = registers[instruction.a];
+        } else {
+            check_division(context,
+                           module,
+                           mir_function,
+                           instruction,
+                           mir_function.ranges[index],
+                           round);
+            code.a = registers[instruction.a];
+            code.b = registers[instruction.b];
+        }
+        function.instructions.push_back(code);
+    }
+
+    function.instructions.push_back(
+        {Opcode::Return, 0, registers[mir_function.result], 0});
+    function.registers = next;
+    return function;
+}
+
+// computed gotos are an extension gcc and clang share, and dispatching
+// through a table of labels, from the end of every handler, predicts far
+// better than one switch.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+std::int64_t run(bytecode::Program const       &program,
+                 bytecode::Function const      &function,
+                 std::span<std::int64_t const> arguments) {
+    std::array<std::int64_t, 128> local;
+    std::vector<std::int64_t>     heap;
+    std::int64_t                 *r = local.data();
+    if (function.registers > local.size()) {
+        heap.resize(function.registers);
+        r = heap.data();
+    }
+    std::ranges::copy(arguments, r);
+    std::ranges::copy(function.constants, r + function.parameters);
+
+    static void *const labels[] = {
+        &&negate,
+        &&negate_exact,
+        &&add,
+        &&add_exact,
+        &&subtract,
+        &&subtract_exact,
+        &&multiply,
+        &&multiply_exact,
+        &&divide,
+        &&divide_exact,
+        &&modulo,
+        &&modulo_exact,
+        &&call,
+        &&return_,
+    };
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+
+    bytecode::Instruction const *pc = function.instructions.data();
+#define INF_DISPATCH() goto *labels[static_cast<std::size_t>(pc->opcode)]
+#define INF_NEXT()                                                             \
+    ++pc;                                                                      \
+    INF_DISPATCH()
+#define INF_CHECKED(builtin)                                                   \
+    if (builtin(r[pc->a], r[pc->b], &r[pc->target])) { __builtin_trap(); }     \
+    INF_NEXT()
+
+    INF_DISPATCH();
+negate:
+    if (__builtin_sub_overflow(std::int64_t{0}, r[pc->a], &r[pc->target])) {
+        __builtin_trap();
+    }
+    INF_NEXT();
+negate_exact:
+    r[pc->target] = -r[pc->a];
+    INF_NEXT();
+add:
+    INF_CHECKED(__builtin_add_overflow);
+add_exact:
+    r[pc->target] = r[pc->a] + r[pc->b];
+    INF_NEXT();
+subtract:
+    INF_CHECKED(__builtin_sub_overflow);
+subtract_exact:
+    r[pc->target] = r[pc->a] - r[pc->b];
+    INF_NEXT();
+multiply:
+    INF_CHECKED(__builtin_mul_overflow);
+multiply_exact:
+    r[pc->target] = r[pc->a] * r[pc->b];
+    INF_NEXT();
+divide:
+    if (r[pc->b] == 0 || (r[pc->a] == min && r[pc->b] == -1)) {
+        __builtin_trap();
+    }
+divide_exact:
+    r[pc->target] = r[pc->a] / r[pc->b];
+    INF_NEXT();
+modulo:
+    // as in codegen, INT64_MIN % -1 is 0 rather than a fault.
+    if (r[pc->b] == 0) { __builtin_trap(); }
+    if (r[pc->b] == -1) {
+        r[pc->target] = 0;
+        INF_NEXT();
+    }
+modulo_exact:
+    r[pc->target] = r[pc->a] % r[pc->b];
+    INF_NEXT();
+call:
+    r[pc->target] = run(program, program.functions[pc->a], {});
+    INF_NEXT();
+return_:
+    return r[pc->a];
+
+#undef INF_CHECKED
+#undef INF_NEXT
+#undef INF_DISPATCH
+}
+#pragma GCC diagnostic pop
+} // namespace
+
+bytecode::Program assemble(Context           &context,
+                           mir::Module const &module,
+                           bool               round) {
+    bytecode::Program program{};
+    program.functions.reserve(module.functions.size());
+    for (std::size_t index = 0; index < module.functions.size(); ++index) {
+        mir::Function const &function = module.functions[index];
+        if (function.entry) {
+            program.entry = static_cast<std::uint32_t>(index);
+        }
+        if (!returns_double(module, function)) {
+            program.functions.push_back(
+                assemble(context, module, function, round));
+            continue;
+        }
+
+        mir::Instruction const &result =
+            function.instructions[function.result];
+        program.returns_double = true;
+        program.real           = real_constant(context,
+                                     module.constants[result.a],
+                                     function.ranges[function.result],
+                                     round);
+        program.functions.emplace_back();
+    }
+    return program;
+}
+
+std::int64_t interpret(bytecode::Program const       &program,
+                       std::span<std::int64_t const> arguments) {
+    bytecode::Function const &entry = program.functions[program.entry];
+    if (program.returns_double) {
+        throw Error{"the expression returns a double"};
+    }
+    if (arguments.size() != entry.parameters) {
+        throw Error{"expression takes " + std::to_string(entry.parameters) +
+                    " parameters, not " + std::to_string(arguments.size())};
+    }
+    return run(program, entry, arguments);
+}
+} // namespace inf
@@ -0,0 +1,146 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "llvm/ExecutionEngine/JITEventListener.h"
+#include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
+#include "llvm/ExecutionEngine/SectionMemoryManager.h"
+#include "llvm/Object/SymbolSize.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Process.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "core/listeners.hpp"
+
+namespace inf {
+namespace {
+bool enabled(char const *variable) {
+    char const *value = std::getenv(variable);
+    return value != nullptr && std::string_view{value} != "0";
+}
+
+// the perf map format: one "start size name" line per function, in hex.
+// perf never forgets an address, so freed objects are left in the map.
+class PerfMapListener final : public llvm::JITEventListener {
+    std::mutex                            mutex;
+    std::unique_ptr<llvm::raw_fd_ostream> map;
+
+  public:
+    void notifyObjectLoaded(
+        ObjectKey,
+        llvm::object::ObjectFile const             &object,
+        llvm::RuntimeDyld::LoadedObjectInfo const &info) override {
+        // the copy made for debuggers has every section at its load
+        // address, so its symbols are where the code is.
+        llvm::object::OwningBinary<llvm::object::ObjectFile> loaded =
+            info.getObjectForDebug(object);
+        if (loaded.getBinary() == nullptr) { return; }
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!open()) { return; }
+        for (auto const &[symbol, size] :
+             llvm::object::computeSymbolSizes(*loaded.getBinary())) {
+            llvm::Expected<llvm::object::SymbolRef::Type> type =
+                symbol.getType();
+            if (!type || *type != llvm::object::SymbolRef::ST_Function) {
+                llvm::consumeError(type.takeError());
+                continue;
+            }
+            llvm::Expected<llvm::StringRef> name    = symbol.getName();
+            llvm::Expected<std::uint64_t>   address = symbol.getAddress();
+            if (!name || !address) {
+                llvm::consumeError(name.takeError());
+                llvm::consumeError(address.takeError());
+                continue;
+            }
+            *map << llvm::format_hex_no_prefix(*address, 1) << " "
+                 << llvm::format_hex_no_prefix(size, 1) << " " << *name
+                 << "\n";
+        }
+        map->flush();
+    }
+
+  private:
+    bool open() {
+        if (map) { return true; }
+
+        std::string path = "/tmp/perf-" +
+                           std::to_string(llvm::sys::Process::getProcessId()) +
+                           ".map";
+        std::error_code error;
+        map = std::make_unique<llvm::raw_fd_ostream>(
+            path, error, llvm::sys::fs::OF_Append | llvm::sys::fs::OF_Text);
+        if (error) { map.reset(); }
+        return map != nullptr;
+    }
+};
+
+// listeners are told when their objects are freed, so must outlive every
+// JIT; like LLVM's own, this one lives as long as the process.
+PerfMapListener &perf_map_listener() {
+    static PerfMapListener listener;
+    return listener;
+}
+} // namespace
+
+JitListeners JitListeners::from_environment() {
+    return {.perf = enabled("INF_JIT_PERF"), .gdb = enabled("INF_JIT_GDB")};
+}
+
+void name_by_location(Context &context, mir::Module const &module) {
+    for (mir::Function const &function : module.functions) {
+        llvm::Function *llvm_function =
+            context.module().getFunction(function.name);
+        if (llvm_function == nullptr) { continue; }
+
+        SourceManager::Presumed where =
+            context.sources().presume(function.range.begin);
+        llvm_function->setName(function.name + "@" + where.file + ":" +
+                               llvm::Twine(where.line) + "." +
+                               llvm::Twine(where.column));
+    }
+}
+
+std::unique_ptr<llvm::orc::ObjectLayer>
+listening_layer(llvm::orc::ExecutionSession &session, JitListeners listeners) {
+    // JITLink has no JITEventListener support, so objects are linked by
+    // RuntimeDyld instead.
+    auto layer = std::make_unique<llvm::orc::RTDyldObjectLinkingLayer>(
+        session, [](auto const &...) {
+            return std::make_unique<llvm::SectionMemoryManager>();
+        });
+
+    if (listeners.perf) {
+        layer->registerJITEventListener(perf_map_listener());
+        // null unless LLVM was built with LLVM_USE_PERF.
+        if (llvm::JITEventListener *jitdump =
+                llvm::JITEventListener::createPerfJITEventListener()) {
+            layer->registerJITEventListener(*jitdump);
+        }
+    }
+    if (listeners.gdb) {
+        layer->registerJITEventListener(
+            *llvm::JITEventListener::createGDBRegistrationListener());
+    }
+    return layer;
+}
+} // namespace inf
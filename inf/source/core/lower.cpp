@@ -0,0 +1,212 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <optional>
+#include <string>
+
+#include "core/lower.hpp"
+#include "imr/symbol.hpp"
+
+namespace inf {
+namespace {
+class Lowering {
+    Context               *context;
+    mir::Module           *module;
+    SymbolTable            symbols;
+    // bound in a scope of their own around each entry.
+    std::span<Label const> parameters;
+
+    struct ExpressionVisitor {
+        Lowering      *lowering;
+        mir::Function *function;
+        SourceRange    range;
+
+        mir::Value operator()(std::monostate) {
+            throw Error::current("lowering an empty ast node");
+        }
+
+        mir::Value operator()(llvm::Value *) {
+            throw Error::current("lowering an llvm::Value ast node");
+        }
+
+        mir::Value operator()(Integer const &integer) {
+            return constant(Rational{integer});
+        }
+
+        mir::Value operator()(Rational const &rational) {
+            return constant(rational);
+        }
+
+        mir::Value constant(Rational value) {
+            std::vector<Rational> &constants = lowering->module->constants;
+            constants.push_back(std::move(value));
+            auto index = static_cast<std::uint32_t>(constants.size() - 1);
+            return function->append({mir::Opcode::Constant, 0, index, 0},
+                                    range);
+        }
+
+        mir::Value operator()(Ast::Variable const &variable) {
+            std::optional<Symbol> symbol =
+                lowering->symbols.find(variable.label);
+            if (!symbol) {
+                lowering->context->error(
+                    {"unknown binding: " + variable.label.str(), range});
+                return function->append(
+                    {mir::Opcode::Constant, 0, lowering->zero(), 0}, range);
+            }
+            if (symbol->kind == Symbol::Kind::Parameter) {
+                return function->append(
+                    {mir::Opcode::Parameter, 0, symbol->index, 0}, range);
+            }
+            return function->append({mir::Opcode::Call, 0, symbol->index, 0},
+                                    range);
+        }
+
+        mir::Value operator()(Ast::Binding const &) {
+            lowering->context->error(
+                {"a binding may only appear as a statement", range});
+            return function->append(
+                {mir::Opcode::Constant, 0, lowering->zero(), 0}, range);
+        }
+
+        mir::Value operator()(Ast::Unop const &unop) {
+            mir::Value operand =
+                lowering->expression(*function, unop.expression);
+            switch (unop.opcode) {
+            case Ast::Unop::Opcode::Negate:
+                return function->append(
+                    {mir::Opcode::Negate, 0, operand, 0}, range);
+            default: throw Error::current("unknown unop");
+            }
+        }
+
+        mir::Value operator()(Ast::Binop const &binop) {
+            mir::Value left  = lowering->expression(*function, binop.left);
+            mir::Value right = lowering->expression(*function, binop.right);
+            return function->append({opcode(binop.opcode), 0, left, right},
+                                    range);
+        }
+
+        static mir::Opcode opcode(Ast::Binop::Opcode opcode) {
+            switch (opcode) {
+            case Ast::Binop::Opcode::Add:      return mir::Opcode::Add;
+            case Ast::Binop::Opcode::Subtract: return mir::Opcode::Subtract;
+            case Ast::Binop::Opcode::Multiply: return mir::Opcode::Multiply;
+            case Ast::Binop::Opcode::Divide:   return mir::Opcode::Divide;
+            case Ast::Binop::Opcode::Modulo:   return mir::Opcode::Modulo;
+            default: throw Error::current("unknown binop");
+            }
+        }
+    };
+
+    std::uint32_t zero() {
+        module->constants.emplace_back(0);
+        return static_cast<std::uint32_t>(module->constants.size() - 1);
+    }
+
+    mir::Value expression(mir::Function &function, Ast::Ptr const &ast) {
+        ExpressionVisitor visitor{this, &function, ast->location()};
+        return std::visit(visitor, ast->get());
+    }
+
+  public:
+    Lowering(Context               &context,
+             mir::Module           &module,
+             std::size_t            statements,
+             std::span<Label const> parameter_labels)
+        : context(&context), module(&module), symbols(),
+          parameters(parameter_labels) {
+        // at most one symbol per statement, so the table never rehashes.
+        symbols.reserve(statements + parameters.size());
+
+        symbols.push();
+        for (std::size_t index = 0; index < parameters.size(); ++index) {
+            if (!symbols.bind(parameters[index], parameter(index))) {
+                context.error(
+                    Error{"duplicate parameter: " + parameters[index].str()});
+            }
+        }
+        symbols.pop();
+    }
+
+    static Symbol parameter(std::size_t index) noexcept {
+        return {Symbol::Kind::Parameter, static_cast<std::uint32_t>(index)};
+    }
+
+    void statement(Ast::Ptr const &ast) {
+        mir::Function function{};
+        function.range      = ast->location();
+        function.parameters = 0;
+
+        if (ast->is<Ast::Binding>()) {
+            Ast::Binding const &binding = ast->as<Ast::Binding>();
+            function.name               = binding.label;
+            function.entry              = false;
+            function.exported           = false;
+            function.result = expression(function, binding.expression);
+        } else {
+            std::string name =
+                "entry." + std::to_string(module->functions.size());
+            function.name       = context->intern_string(name);
+            function.entry      = true;
+            function.exported   = false;
+            function.parameters = static_cast<std::uint32_t>(parameters.size());
+
+            symbols.push();
+            for (std::size_t index = 0; index < parameters.size(); ++index) {
+                symbols.bind(parameters[index], parameter(index));
+            }
+            function.result = expression(function, ast);
+            symbols.pop();
+        }
+
+        auto index = static_cast<std::uint32_t>(module->functions.size());
+        module->functions.emplace_back(std::move(function));
+        // bound after lowering its own expression, so a binding can never
+        // refer to itself.
+        if (ast->is<Ast::Binding>()) {
+            symbols.bind(ast->as<Ast::Binding>().label,
+                         {Symbol::Kind::Binding, index});
+        }
+    }
+
+    void exported(Label label) {
+        std::optional<Symbol> symbol = symbols.find(label);
+        if (!symbol) {
+            context->error(Error{"unknown export: " + label.str()});
+            return;
+        }
+        module->functions[symbol->index].exported = true;
+    }
+};
+} // namespace
+
+mir::Module lower(Context                  &context,
+                  std::span<Ast::Ptr const> statements,
+                  std::span<Label const>    parameters,
+                  std::span<Label const>    exports) {
+    mir::Module module;
+    Lowering    lowering{context, module, statements.size(), parameters};
+    for (Ast::Ptr const &statement : statements) {
+        lowering.statement(statement);
+    }
+    for (Label label : exports) {
+        lowering.exported(label);
+    }
+    return module;
+}
+} // namespace inf
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "llvm/Passes/PassBuilder.h"
+
+#include "core/optimize.hpp"
+
+namespace inf {
+void optimize(Context &context, unsigned level) {
+    optimize(context.module(), &context.target_machine(), level);
+}
+
+void optimize(llvm::Module        &module,
+              llvm::TargetMachine *target_machine,
+              unsigned             level) {
+    llvm::OptimizationLevel optimization_level;
+    switch (level) {
+    case 0:  optimization_level = llvm::OptimizationLevel::O0; break;
+    case 1:  optimization_level = llvm::OptimizationLevel::O1; break;
+    case 2:  optimization_level = llvm::OptimizationLevel::O2; break;
+    default: optimization_level = llvm::OptimizationLevel::O3; break;
+    }
+
+    llvm::LoopAnalysisManager     loop_analyses;
+    llvm::FunctionAnalysisManager function_analyses;
+    llvm::CGSCCAnalysisManager    cgscc_analyses;
+    llvm::ModuleAnalysisManager   module_analyses;
+
+    llvm::PassBuilder pass_builder{target_machine};
+    pass_builder.registerModuleAnalyses(module_analyses);
+    pass_builder.registerCGSCCAnalyses(cgscc_analyses);
+    pass_builder.registerFunctionAnalyses(function_analyses);
+    pass_builder.registerLoopAnalyses(loop_analyses);
+    pass_builder.crossRegisterProxies(loop_analyses,
+                                      function_analyses,
+                                      cgscc_analyses,
+                                      module_analyses);
+
+    llvm::ModulePassManager pass_manager =
+        level == 0
+            ? pass_builder.buildO0DefaultPipeline(optimization_level)
+            : pass_builder.buildPerModuleDefaultPipeline(optimization_level);
+    pass_manager.run(module, module_analyses);
+}
+} // namespace inf
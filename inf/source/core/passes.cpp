@@ -0,0 +1,451 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+
+#include "core/passes.hpp"
+
+namespace inf::mir {
+namespace {
+class Numbering {
+    using Key = std::pair<std::uint64_t, std::uint32_t>;
+
+    Module                    *module;
+    // merge identical instructions and apply identities, or only fold.
+    bool                       merge;
+    std::vector<Instruction>   instructions;
+    std::vector<SourceRange>   ranges;
+    llvm::DenseMap<Key, Value> table;
+    std::map<Rational, Value>  constants;
+
+    Rational const *constant(Value value) const {
+        Instruction const &instruction = instructions[value];
+        if (instruction.opcode != Opcode::Constant) { return nullptr; }
+        return &module->constants[instruction.a];
+    }
+
+    bool is(Value value, long integer) const {
+        Rational const *c = constant(value);
+        return c != nullptr && *c == integer;
+    }
+
+    Value emit(Instruction instruction, SourceRange range) {
+        Value *slot = nullptr;
+        if (merge) {
+            Key key{(static_cast<std::uint64_t>(instruction.opcode) << 32) |
+                        instruction.a,
+                    instruction.b};
+            auto [cursor, inserted] = table.try_emplace(key, 0);
+            if (!inserted) { return cursor->second; }
+            slot = &cursor->second;
+        }
+
+        instructions.push_back(instruction);
+        ranges.push_back(range);
+        auto value = static_cast<Value>(instructions.size() - 1);
+        if (slot != nullptr) { *slot = value; }
+        return value;
+    }
+
+    Value constant(Rational value, SourceRange range) {
+        auto cursor = constants.find(value);
+        if (cursor != constants.end()) { return cursor->second; }
+
+        module->constants.push_back(value);
+        auto  index  = static_cast<std::uint32_t>(module->constants.size() - 1);
+        Value result = emit({Opcode::Constant, 0, index, 0}, range);
+        constants.emplace(std::move(value), result);
+        return result;
+    }
+
+    // folding is exact: the result of every operation on rationals is
+    // again a rational, so nothing is rounded until codegen.
+    std::optional<Rational> fold(Opcode opcode, Value a, Value b) const {
+        Rational const *x = constant(a);
+        if (x == nullptr) { return std::nullopt; }
+        if (opcode == Opcode::Negate) { return Rational{-*x}; }
+
+        Rational const *y = constant(b);
+        if (y == nullptr) { return std::nullopt; }
+
+        switch (opcode) {
+        case Opcode::Add:      return Rational{*x + *y};
+        case Opcode::Subtract: return Rational{*x - *y};
+        case Opcode::Multiply: return Rational{*x * *y};
+        case Opcode::Divide:
+            if (y->is_zero()) { return std::nullopt; }
+            return Rational{*x / *y};
+        case Opcode::Modulo:
+            if (y->is_zero()) { return std::nullopt; }
+            return Rational{*x - *y * Rational{truncate(Rational{*x / *y})}};
+        default: return std::nullopt;
+        }
+    }
+
+    // the value an identity reduces a binop to, or no_value.
+    Value simplify(Instruction const &instruction, SourceRange range) {
+        Value a = instruction.a;
+        Value b = instruction.b;
+
+        switch (instruction.opcode) {
+        case Opcode::Negate: {
+            Instruction const &operand = instructions[a];
+            if (operand.opcode == Opcode::Negate) { return operand.a; }
+            return no_value;
+        }
+        case Opcode::Add:
+            if (is(a, 0)) { return b; }
+            if (is(b, 0)) { return a; }
+            return no_value;
+        case Opcode::Subtract:
+            if (is(b, 0)) { return a; }
+            if (a == b) { return constant(Rational{0}, range); }
+            return no_value;
+        case Opcode::Multiply:
+            if (is(a, 1)) { return b; }
+            if (is(b, 1)) { return a; }
+            if (is(a, 0) || is(b, 0)) { return constant(Rational{0}, range); }
+            return no_value;
+        case Opcode::Divide:
+            if (is(b, 1)) { return a; }
+            return no_value;
+        case Opcode::Modulo:
+            // operands which are not constants are integers at runtime.
+            if (is(b, 1) || is(b, -1)) { return constant(Rational{0}, range); }
+            return no_value;
+        default: return no_value;
+        }
+    }
+
+  public:
+    Numbering(Module &module, bool merge) : module(&module), merge(merge) {}
+
+    void run(Function &function) {
+        instructions.clear();
+        ranges.clear();
+        table.clear();
+        constants.clear();
+        instructions.reserve(function.instructions.size());
+        ranges.reserve(function.instructions.size());
+
+        std::vector<Value> map(function.instructions.size(), no_value);
+        for (std::size_t index = 0; index < map.size(); ++index) {
+            Instruction instruction = function.instructions[index];
+            SourceRange range       = function.ranges[index];
+
+            switch (instruction.opcode) {
+            case Opcode::Constant:
+                map[index] =
+                    constant(module->constants[instruction.a], range);
+                continue;
+
+            case Opcode::Parameter:
+                map[index] = emit(instruction, range);
+                continue;
+
+            case Opcode::Call: {
+                // bindings are pure, so a callee which folded to a constant
+                // is that constant.
+                Function const &callee = module->functions[instruction.a];
+                Instruction const &result =
+                    callee.instructions[callee.result];
+                if (callee.parameters == 0 &&
+                    result.opcode == Opcode::Constant) {
+                    map[index] = constant(module->constants[result.a], range);
+                } else {
+                    map[index] = emit(instruction, range);
+                }
+                continue;
+            }
+
+            default: break;
+            }
+
+            instruction.a = map[instruction.a];
+            if (is_binop(instruction.opcode)) {
+                instruction.b = map[instruction.b];
+            }
+            if (is_commutative(instruction.opcode) &&
+                instruction.b < instruction.a) {
+                std::swap(instruction.a, instruction.b);
+            }
+            instruction.flags = Instruction::None;
+
+            if (auto folded =
+                    fold(instruction.opcode, instruction.a, instruction.b)) {
+                map[index] = constant(std::move(*folded), range);
+            } else if (Value simple =
+                           merge ? simplify(instruction, range) : no_value;
+                       simple != no_value) {
+                map[index] = simple;
+            } else {
+                map[index] = emit(instruction, range);
+            }
+        }
+
+        function.result       = map[function.result];
+        function.instructions = std::move(instructions);
+        function.ranges       = std::move(ranges);
+        instructions          = {};
+        ranges                = {};
+    }
+};
+
+void remove_dead_instructions(Function &function) {
+    std::size_t       size = function.instructions.size();
+    std::vector<bool> used(size, false);
+    used[function.result] = true;
+
+    for (std::size_t index = size; index-- > 0;) {
+        if (!used[index]) { continue; }
+        Instruction const &instruction = function.instructions[index];
+        if (instruction.opcode == Opcode::Negate) {
+            used[instruction.a] = true;
+        } else if (is_binop(instruction.opcode)) {
+            used[instruction.a] = true;
+            used[instruction.b] = true;
+        }
+    }
+
+    std::vector<Value> map(size, no_value);
+    Value              next = 0;
+    for (std::size_t index = 0; index < size; ++index) {
+        if (!used[index]) { continue; }
+
+        Instruction instruction = function.instructions[index];
+        if (instruction.opcode == Opcode::Negate) {
+            instruction.a = map[instruction.a];
+        } else if (is_binop(instruction.opcode)) {
+            instruction.a = map[instruction.a];
+            instruction.b = map[instruction.b];
+        }
+
+        function.instructions[next] = instruction;
+        function.ranges[next]       = function.ranges[index];
+        map[index]                  = next++;
+    }
+
+    function.instructions.resize(next);
+    function.ranges.resize(next);
+    function.result = map[function.result];
+}
+
+struct Interval {
+    Integer low;
+    Integer high;
+};
+
+Integer const i64_min{std::numeric_limits<std::int64_t>::min()};
+Integer const i64_max{std::numeric_limits<std::int64_t>::max()};
+
+bool fits64(Interval const &interval) {
+    return i64_min <= interval.low && interval.high <= i64_max;
+}
+
+Interval hull(std::initializer_list<Integer> values) {
+    auto [low, high] = std::minmax(values);
+    return {low, high};
+}
+
+Interval divide(Interval const &a, Interval const &b) {
+    // truncating division is monotonic in each operand while the sign of
+    // the divisor is fixed, so the extremes lie at the ends of the
+    // positive and negative parts of b.
+    std::vector<Integer> divisors;
+    if (b.high >= 1) {
+        divisors.push_back(b.low >= 1 ? b.low : Integer{1});
+        divisors.push_back(b.high);
+    }
+    if (b.low <= -1) {
+        divisors.push_back(b.low);
+        divisors.push_back(b.high <= -1 ? b.high : Integer{-1});
+    }
+    if (divisors.empty()) { return {0, 0}; }
+
+    Interval result{a.low / divisors.front(), a.low / divisors.front()};
+    for (Integer const &divisor : divisors) {
+        for (Integer const *dividend : {&a.low, &a.high}) {
+            Integer quotient = *dividend / divisor;
+            if (quotient < result.low) { result.low = quotient; }
+            if (result.high < quotient) { result.high = quotient; }
+        }
+    }
+    return result;
+}
+
+Interval modulo(Interval const &a, Interval const &b) {
+    // the remainder takes the sign of the dividend and is smaller in
+    // magnitude than the divisor.
+    Integer bound = std::max(Integer{abs(b.low)}, Integer{abs(b.high)}) - 1;
+    if (bound < 0) { return {0, 0}; }
+
+    Integer low  = a.low < 0 ? std::max(a.low, Integer{-bound}) : Integer{0};
+    Integer high = a.high > 0 ? std::min(a.high, bound) : Integer{0};
+    return {low, high};
+}
+} // namespace
+
+void number_values(Module &module) {
+    Numbering numbering{module, true};
+    for (Function &function : module.functions) {
+        numbering.run(function);
+    }
+}
+
+void fold_constants(Module &module) {
+    Numbering numbering{module, false};
+    for (Function &function : module.functions) {
+        numbering.run(function);
+    }
+    remove_dead_bindings(module);
+}
+
+void remove_dead_bindings(Module &module) {
+    for (Function &function : module.functions) {
+        remove_dead_instructions(function);
+    }
+
+    // callees always precede their callers, so one backwards walk finds
+    // every function reachable from an entry or export.
+    std::size_t       size = module.functions.size();
+    std::vector<bool> live(size, false);
+    for (std::size_t index = size; index-- > 0;) {
+        Function const &function = module.functions[index];
+        if (function.entry || function.exported) { live[index] = true; }
+        if (!live[index]) { continue; }
+
+        for (Instruction const &instruction : function.instructions) {
+            if (instruction.opcode == Opcode::Call) {
+                live[instruction.a] = true;
+            }
+        }
+    }
+
+    std::vector<Value> map(size, no_value);
+    Value              next = 0;
+    for (std::size_t index = 0; index < size; ++index) {
+        if (!live[index]) { continue; }
+
+        Function &function = module.functions[index];
+        for (Instruction &instruction : function.instructions) {
+            if (instruction.opcode == Opcode::Call) {
+                instruction.a = map[instruction.a];
+            }
+        }
+
+        if (next != index) {
+            module.functions[next] = std::move(function);
+        }
+        map[index] = next++;
+    }
+    module.functions.resize(next);
+}
+
+void analyze_ranges(Module &module) {
+    Interval const        unknown{i64_min, i64_max};
+    std::vector<Interval> results;
+    results.reserve(module.functions.size());
+
+    for (Function &function : module.functions) {
+        std::vector<Interval> ranges;
+        ranges.reserve(function.instructions.size());
+
+        for (Instruction &instruction : function.instructions) {
+            Interval range;
+            bool     faults   = false;
+            instruction.flags = Instruction::None;
+
+            switch (instruction.opcode) {
+            case Opcode::Constant: {
+                // codegen truncates a constant which is not an integer, or
+                // rejects it, so the runtime value is at most this.
+                Integer value = truncate(module.constants[instruction.a]);
+                range         = {value, value};
+                break;
+            }
+            case Opcode::Parameter: range = unknown; break;
+            case Opcode::Call:      range = results[instruction.a]; break;
+            case Opcode::Negate: {
+                Interval const &a = ranges[instruction.a];
+                range             = {-a.high, -a.low};
+                break;
+            }
+            case Opcode::Add: {
+                Interval const &a = ranges[instruction.a];
+                Interval const &b = ranges[instruction.b];
+                range             = {a.low + b.low, a.high + b.high};
+                break;
+            }
+            case Opcode::Subtract: {
+                Interval const &a = ranges[instruction.a];
+                Interval const &b = ranges[instruction.b];
+                range             = {a.low - b.high, a.high - b.low};
+                break;
+            }
+            case Opcode::Multiply: {
+                Interval const &a = ranges[instruction.a];
+                Interval const &b = ranges[instruction.b];
+                range             = hull({a.low * b.low,
+                                          a.low * b.high,
+                                          a.high * b.low,
+                                          a.high * b.high});
+                break;
+            }
+            case Opcode::Divide:
+            case Opcode::Modulo: {
+                Interval const &a = ranges[instruction.a];
+                Interval const &b = ranges[instruction.b];
+                if (b.low > 0 || b.high < 0) {
+                    instruction.flags |= Instruction::NonZeroDivisor;
+                }
+                range = instruction.opcode == Opcode::Divide ? divide(a, b)
+                                                             : modulo(a, b);
+                // INT64_MIN % -1 is 0, which fits, but the machine faults
+                // on it as on INT64_MIN / -1, so neither is exact unless
+                // the pair cannot occur.
+                faults = a.low <= i64_min && b.low <= -1 && b.high >= -1;
+                break;
+            }
+            default: range = unknown; break;
+            }
+
+            if (fits64(range) && !faults) {
+                instruction.flags |= Instruction::Exact64;
+            } else {
+                // an inexact operation traps rather than produce a value
+                // outside of 64 bits, so later uses see at most this.
+                range = {std::max(range.low, i64_min),
+                         std::min(range.high, i64_max)};
+            }
+            ranges.emplace_back(std::move(range));
+        }
+
+        results.emplace_back(ranges[function.result]);
+    }
+}
+
+void optimize(Module &module) {
+    number_values(module);
+    remove_dead_bindings(module);
+    analyze_ranges(module);
+}
+} // namespace inf::mir
@@ -0,0 +1,135 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <utility>
+
+#include "core/reachable.hpp"
+#include "imr/symbol.hpp"
+
+namespace inf {
+namespace {
+// the statements each statement refers to, resolved in program order.
+class References {
+    Context                                    *context;
+    SymbolTable                                 symbols;
+    // statement i refers to targets[starts[i]] up to targets[starts[i + 1]].
+    std::vector<std::uint32_t>                  starts;
+    std::vector<std::uint32_t>                  targets;
+    // names which resolved to nothing, with the statement they are in.
+    std::vector<std::pair<std::uint32_t, Error>> unresolved;
+
+    void walk(std::uint32_t statement, Ast const &ast) {
+        if (ast.is<Ast::Variable>()) {
+            Label label = ast.as<Ast::Variable>().label;
+            if (std::optional<Symbol> symbol = symbols.find(label)) {
+                targets.push_back(symbol->index);
+            } else {
+                unresolved.emplace_back(
+                    statement,
+                    Error{"unknown binding: " + label.str(), ast.location()});
+            }
+        } else if (ast.is<Ast::Unop>()) {
+            walk(statement, *ast.as<Ast::Unop>().expression);
+        } else if (ast.is<Ast::Binop>()) {
+            walk(statement, *ast.as<Ast::Binop>().left);
+            walk(statement, *ast.as<Ast::Binop>().right);
+        }
+    }
+
+  public:
+    References(Context &context, std::span<Ast::Ptr const> statements)
+        : context(&context), symbols(), starts(), targets(), unresolved() {
+        symbols.reserve(statements.size());
+        starts.reserve(statements.size() + 1);
+        for (std::size_t index = 0; index < statements.size(); ++index) {
+            auto      statement = static_cast<std::uint32_t>(index);
+            Ast const &ast      = *statements[index];
+            starts.push_back(static_cast<std::uint32_t>(targets.size()));
+            if (!ast.is<Ast::Binding>()) {
+                walk(statement, ast);
+                continue;
+            }
+
+            // bound after its own expression is walked, as in lower.
+            Ast::Binding const &binding = ast.as<Ast::Binding>();
+            walk(statement, *binding.expression);
+            symbols.bind(binding.label, {Symbol::Kind::Binding, statement});
+        }
+        starts.push_back(static_cast<std::uint32_t>(targets.size()));
+    }
+
+    std::span<std::uint32_t const> of(std::size_t statement) const {
+        return std::span{targets}.subspan(
+            starts[statement], starts[statement + 1] - starts[statement]);
+    }
+
+    // the statement an export names, if any.
+    std::optional<std::uint32_t> exported(Label label) const {
+        std::optional<Symbol> symbol = symbols.find(label);
+        if (!symbol) { return std::nullopt; }
+        return symbol->index;
+    }
+
+    void report_unresolved(std::vector<bool> const &live) {
+        for (auto &[statement, error] : unresolved) {
+            if (!live[statement]) { context->error(std::move(error)); }
+        }
+    }
+};
+} // namespace
+
+void retain_reachable(Context                &context,
+                      std::vector<Ast::Ptr>  &statements,
+                      std::span<Label const> exports) {
+    References references{context, statements};
+
+    std::vector<bool>          live(statements.size(), false);
+    std::vector<std::uint32_t> pending;
+    auto                       reach = [&](std::uint32_t statement) {
+        if (live[statement]) { return; }
+        live[statement] = true;
+        pending.push_back(statement);
+    };
+
+    for (std::size_t index = 0; index < statements.size(); ++index) {
+        if (!statements[index]->is<Ast::Binding>()) {
+            reach(static_cast<std::uint32_t>(index));
+        }
+    }
+    for (Label label : exports) {
+        if (std::optional<std::uint32_t> statement =
+                references.exported(label)) {
+            reach(*statement);
+        }
+    }
+    while (!pending.empty()) {
+        std::uint32_t statement = pending.back();
+        pending.pop_back();
+        for (std::uint32_t target : references.of(statement)) {
+            reach(target);
+        }
+    }
+    references.report_unresolved(live);
+
+    std::size_t next = 0;
+    for (std::size_t index = 0; index < statements.size(); ++index) {
+        if (live[index]) { statements[next++] = std::move(statements[index]); }
+    }
+    statements.resize(next);
+}
+} // namespace inf
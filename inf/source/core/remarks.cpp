@@ -0,0 +1,149 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/IR/DebugInfoMetadata.h"
+#include "llvm/IR/DiagnosticHandler.h"
+#include "llvm/IR/DiagnosticInfo.h"
+#include "llvm/IR/LLVMRemarkStreamer.h"
+#include "llvm/Remarks/RemarkStreamer.h"
+
+#include "core/remarks.hpp"
+
+namespace inf {
+// keeps a copy of every remark the streamer is given, so the summary
+// needs no parser for either file format.
+class Remarks::Collector final : public llvm::DiagnosticHandler {
+    Remarks *remarks;
+
+  public:
+    explicit Collector(Remarks *remarks) : remarks(remarks) {}
+
+    bool handleDiagnostics(llvm::DiagnosticInfo const &info) override {
+        auto const *remark =
+            llvm::dyn_cast<llvm::DiagnosticInfoOptimizationBase>(&info);
+        if (remark == nullptr) { return false; }
+        if (remarks->filter && !remarks->filter->match(remark->getPassName())) {
+            return true;
+        }
+
+        Remark::Kind kind = remark->isPassed()   ? Remark::Kind::Passed
+                            : remark->isMissed() ? Remark::Kind::Missed
+                                                 : Remark::Kind::Analysis;
+        Remark &result = remarks->remarks.emplace_back(
+            kind,
+            remark->getFunction().getName().str(),
+            remark->getPassName().str(),
+            remark->getMsg(),
+            std::string{},
+            0,
+            0);
+
+        llvm::DiagnosticLocation location = remark->getLocation();
+        if (location.isValid()) {
+            result.file   = location.getRelativePath().str();
+            result.line   = location.getLine();
+            result.column = location.getColumn();
+        }
+        return true;
+    }
+};
+
+Remarks::Remarks(Context         &context,
+                 std::string_view path,
+                 std::string_view filter,
+                 std::string_view format)
+    : context(&context), filter(), file(), remarks() {
+    if (!filter.empty()) {
+        this->filter.emplace(llvm::StringRef{filter.data(), filter.size()});
+        std::string error;
+        if (!this->filter->isValid(error)) {
+            throw Error{"remarks filter: " + error};
+        }
+    }
+
+    auto result = llvm::setupLLVMOptimizationRemarks(
+        context.ir_context(),
+        llvm::StringRef{path.data(), path.size()},
+        llvm::StringRef{filter.data(), filter.size()},
+        llvm::StringRef{format.data(), format.size()},
+        /* RemarksWithHotness = */ false);
+    if (!result) {
+        throw Error{"remarks: " + llvm::toString(result.takeError())};
+    }
+    file = std::move(*result);
+    context.ir_context().setDiagnosticHandler(
+        std::make_unique<Collector>(this));
+}
+
+Remarks::~Remarks() { finish(); }
+
+void Remarks::finish() {
+    if (!file) { return; }
+
+    llvm::LLVMContext &ir_context = context->ir_context();
+    ir_context.setDiagnosticHandler(
+        std::make_unique<llvm::DiagnosticHandler>());
+    ir_context.setLLVMRemarkStreamer(nullptr);
+    ir_context.setMainRemarkStreamer(nullptr);
+    file->keep();
+    file.reset();
+}
+
+void Remarks::summarize(std::ostream &out) const {
+    // each function is one statement; keep them in the order their first
+    // remark was emitted.
+    std::vector<std::vector<Remark const *>> statements;
+    llvm::StringMap<std::size_t>             index;
+    for (Remark const &remark : remarks) {
+        auto [cursor, inserted] =
+            index.try_emplace(remark.function, statements.size());
+        if (inserted) { statements.emplace_back(); }
+        statements[cursor->second].push_back(&remark);
+    }
+
+    for (std::vector<Remark const *> const &statement : statements) {
+        std::size_t passed = 0;
+        std::size_t missed = 0;
+        for (Remark const *remark : statement) {
+            if (remark->kind == Remark::Kind::Passed) { ++passed; }
+            if (remark->kind == Remark::Kind::Missed) { ++missed; }
+        }
+
+        std::string const    &name     = statement.front()->function;
+        llvm::Function const *function = context->module().getFunction(name);
+        out << name;
+        if (function != nullptr && function->getSubprogram() != nullptr) {
+            out << " (" << function->getSubprogram()->getFilename().str()
+                << ":" << function->getSubprogram()->getLine() << ")";
+        }
+        out << ": " << passed << " applied, " << missed << " missed\n";
+
+        for (Remark const *remark : statement) {
+            if (remark->kind != Remark::Kind::Missed) { continue; }
+            out << "  ";
+            if (remark->file.empty()) {
+                out << "<unknown>";
+            } else {
+                out << remark->file << ":" << remark->line << "."
+                    << remark->column;
+            }
+            out << ": " << remark->pass << ": " << remark->message << "\n";
+        }
+    }
+}
+} // namespace inf
@@ -0,0 +1,121 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <string_view>
+#include <thread>
+
+#include "core/tokenize.hpp"
+
+namespace inf {
+namespace {
+// below this a chunk is not worth a thread.
+constexpr std::size_t min_chunk_size = 64 * 1024;
+
+struct Chunk {
+    std::string_view              text;
+    Location                      base;
+    std::vector<yy::Lexer::Token> tokens;
+    ErrorList                     errors;
+};
+
+// split text into at most count pieces of about equal size, each but the
+// last ending just after a ';'.
+std::vector<std::string_view> split(std::string_view text, std::size_t count) {
+    std::vector<std::string_view> pieces;
+    std::size_t                   begin = 0;
+    for (std::size_t index = 1; index < count; ++index) {
+        std::size_t target = std::max(begin, text.size() * index / count);
+        std::size_t end    = text.find(';', target);
+        if (end == std::string_view::npos) { break; }
+
+        pieces.push_back(text.substr(begin, end + 1 - begin));
+        begin = end + 1;
+    }
+    pieces.push_back(text.substr(begin));
+    return pieces;
+}
+
+void lex(Context &context, Chunk &chunk) {
+    yy::Lexer lexer{&context};
+    lexer.set_view(chunk.text, chunk.base);
+    lexer.set_errors(&chunk.errors);
+
+    // about one token per four bytes of typical source.
+    chunk.tokens.reserve(chunk.text.size() / 4);
+    while (true) {
+        yy::Lexer::Token token = lexer.advance();
+        bool             end   = token.is<yy::Lexer::Token::End>();
+        chunk.tokens.emplace_back(std::move(token));
+        if (end) { break; }
+    }
+}
+} // namespace
+
+std::vector<yy::Lexer::Token>
+tokenize(Context &context, Location source, unsigned threads) {
+    std::string_view text  = context.sources().text(source);
+    std::size_t      count = std::clamp<std::size_t>(
+        text.size() / min_chunk_size, 1, std::max(threads, 1u));
+
+    std::vector<Chunk> chunks;
+    for (std::string_view piece : split(text, count)) {
+        auto offset = static_cast<std::uint32_t>(piece.data() - text.data());
+        chunks.emplace_back(piece,
+                            source + offset,
+                            std::vector<yy::Lexer::Token>{},
+                            ErrorList{&context.memory()});
+    }
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (std::size_t index = 1; index < chunks.size(); ++index) {
+            workers.emplace_back(
+                [&context, &chunk = chunks[index]]() { lex(context, chunk); });
+        }
+        lex(context, chunks.front());
+    }
+
+    // splice the chunks together in order, dropping every End but the
+    // last and renumbering errors into the context's list.
+    std::size_t size = 0;
+    for (Chunk const &chunk : chunks) {
+        size += chunk.tokens.size();
+    }
+    std::vector<yy::Lexer::Token> tokens;
+    tokens.reserve(size);
+
+    for (std::size_t index = 0; index < chunks.size(); ++index) {
+        Chunk &chunk  = chunks[index];
+        auto   offset = context.errors().size();
+        for (Error &error : chunk.errors) {
+            context.error(std::move(error));
+        }
+
+        if (index + 1 != chunks.size()) { chunk.tokens.pop_back(); }
+        for (yy::Lexer::Token &token : chunk.tokens) {
+            if (token.is<yy::Lexer::Token::Error>()) {
+                token.as<yy::Lexer::Token::Error>().index += offset;
+            }
+            tokens.emplace_back(std::move(token));
+        }
+        chunk.tokens = {};
+    }
+    return tokens;
+}
+} // namespace inf
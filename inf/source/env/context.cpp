@@ -17,28 +17,53 @@
 
 #include "env/context.hpp"
 
-#include "llvm/TargetParser/Host.h"
 #include "llvm/MC/TargetRegistry.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/TargetParser/Host.h"
+#include "llvm/TargetParser/SubtargetFeature.h"
 
 namespace inf {
 std::string Context::host_cpu_features() noexcept {
-    std::string                 features;
+    llvm::SubtargetFeatures     features;
     const llvm::StringMap<bool> feature_map = llvm::sys::getHostCPUFeatures();
 
-    return features;
+    for (auto &feature : feature_map) {
+        features.AddFeature(feature.getKey(), feature.getValue());
+    }
+
+    return features.getString();
 }
 
 Context::Context(Label module_name)
-    : llvm_context(), llvm_module(module_name, llvm_context),
-      llvm_ir_builder(llvm_context) {
-    llvm::StringRef cpu    = llvm::sys::getHostCPUName();
-    std::string triple = llvm::sys::getProcessTriple();
-    std::string cpu_features = host_cpu_features();
-    std::string error_string;
+    : memory_resource(), llvm_triple(llvm::sys::getProcessTriple()),
+      llvm_cpu(llvm::sys::getHostCPUName()),
+      llvm_cpu_features(host_cpu_features()), llvm_context(),
+      llvm_module(module_name, llvm_context), llvm_ir_builder(llvm_context),
+      string_interner(), source_manager(), error_list(&memory_resource),
+      ast_memory_resource(&memory_resource) {
+    string_interner.getAllocator() = ResourceAllocator{&memory_resource};
+
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    llvm_target_machine = create_target_machine();
+    llvm_module.setTargetTriple(llvm_triple);
+    llvm_module.setDataLayout(llvm_target_machine->createDataLayout());
+}
+
+std::unique_ptr<llvm::TargetMachine> Context::create_target_machine() const {
+    std::string         error_string;
     const llvm::Target *target =
-        llvm::TargetRegistry::lookupTarget(triple, error_string);
+        llvm::TargetRegistry::lookupTarget(llvm_triple.str(), error_string);
+    if (target == nullptr) { throw Error::current(std::move(error_string)); }
 
-    llvm_target_machine = target->createTargetMachine(triple, cpu, cpu_features, );
+    llvm::TargetOptions options;
+    return std::unique_ptr<llvm::TargetMachine>{
+        target->createTargetMachine(llvm_triple,
+                                    llvm_cpu,
+                                    llvm_cpu_features,
+                                    options,
+                                    llvm::Reloc::PIC_)};
 }
 
 ErrorList::size_type Context::error(Error error) {
@@ -51,6 +76,7 @@ Error const &Context::error_at(ErrorList::size_type index) const {
 }
 
 Label Context::intern_string(llvm::StringRef string) {
+    std::lock_guard<std::mutex> lock{string_interner_mutex};
     auto [iter, cons] = string_interner.insert(string);
     return iter->getKey();
 }
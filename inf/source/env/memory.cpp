@@ -0,0 +1,154 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+
+#include <gmp.h>
+
+#include "env/memory.hpp"
+
+namespace inf {
+char const *to_string(Phase phase) noexcept {
+    switch (phase) {
+    case Phase::Setup:    return "setup";
+    case Phase::Parse:    return "parse";
+    case Phase::Lower:    return "lower";
+    case Phase::Optimize: return "optimize";
+    case Phase::Emit:     return "emit";
+    default:              return "unknown";
+    }
+}
+
+TrackingResource::TrackingResource(std::pmr::memory_resource *upstream)
+    : upstream(upstream), current(Phase::Setup), live_bytes(0), counters() {}
+
+void *TrackingResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    void *pointer = upstream->allocate(bytes, alignment);
+    record_allocation(bytes);
+    return pointer;
+}
+
+void TrackingResource::do_deallocate(void       *pointer,
+                                     std::size_t bytes,
+                                     std::size_t alignment) {
+    upstream->deallocate(pointer, bytes, alignment);
+    record_deallocation(bytes);
+}
+
+bool TrackingResource::do_is_equal(
+    std::pmr::memory_resource const &other) const noexcept {
+    return this == &other;
+}
+
+void TrackingResource::record_allocation(std::size_t bytes) noexcept {
+    Counters   &phase = counters[static_cast<std::size_t>(current.load())];
+    std::size_t live  = live_bytes.fetch_add(bytes) + bytes;
+
+    phase.allocated_bytes.fetch_add(bytes);
+    phase.allocations.fetch_add(1);
+
+    std::size_t peak = phase.peak_bytes.load();
+    while (peak < live && !phase.peak_bytes.compare_exchange_weak(peak, live))
+        ;
+}
+
+void TrackingResource::record_deallocation(std::size_t bytes) noexcept {
+    Counters &phase = counters[static_cast<std::size_t>(current.load())];
+
+    // GMP limbs allocated before its hooks were installed are still freed
+    // through them, so live bytes stop at zero rather than wrap.
+    std::size_t live = live_bytes.load();
+    while (!live_bytes.compare_exchange_weak(live,
+                                             live - std::min(live, bytes)))
+        ;
+    phase.deallocated_bytes.fetch_add(bytes);
+    phase.deallocations.fetch_add(1);
+}
+
+AllocationStats TrackingResource::stats(Phase phase) const noexcept {
+    Counters const &counter = counters[static_cast<std::size_t>(phase)];
+    return {counter.allocated_bytes.load(),
+            counter.deallocated_bytes.load(),
+            counter.allocations.load(),
+            counter.deallocations.load(),
+            counter.peak_bytes.load()};
+}
+
+void TrackingResource::report(std::ostream &out) const {
+    out << std::left << std::setw(8) << "phase" << std::right
+        << std::setw(14) << "allocated" << std::setw(14) << "freed"
+        << std::setw(10) << "allocs" << std::setw(10) << "frees"
+        << std::setw(14) << "peak" << "\n";
+
+    for (std::size_t index = 0; index < phase_count; ++index) {
+        Phase           phase = static_cast<Phase>(index);
+        AllocationStats stats = this->stats(phase);
+        out << std::left << std::setw(8) << to_string(phase) << std::right
+            << std::setw(14) << stats.allocated_bytes << std::setw(14)
+            << stats.deallocated_bytes << std::setw(10) << stats.allocations
+            << std::setw(10) << stats.deallocations << std::setw(14)
+            << stats.peak_bytes << "\n";
+    }
+
+    out << "live at exit: " << live() << " bytes\n";
+}
+
+namespace {
+std::atomic<TrackingResource *> gmp_resource{nullptr};
+
+void *gmp_allocate(std::size_t bytes) {
+    void *pointer = std::malloc(bytes);
+    if (pointer == nullptr) { std::abort(); }
+    if (auto *resource = gmp_resource.load()) {
+        resource->record_allocation(bytes);
+    }
+    return pointer;
+}
+
+void *gmp_reallocate(void *pointer, std::size_t old_bytes, std::size_t bytes) {
+    void *result = std::realloc(pointer, bytes);
+    if (result == nullptr) { std::abort(); }
+    if (auto *resource = gmp_resource.load()) {
+        resource->record_deallocation(old_bytes);
+        resource->record_allocation(bytes);
+    }
+    return result;
+}
+
+void gmp_free(void *pointer, std::size_t bytes) {
+    std::free(pointer);
+    if (auto *resource = gmp_resource.load()) {
+        resource->record_deallocation(bytes);
+    }
+}
+} // namespace
+
+GmpAllocationScope::GmpAllocationScope(TrackingResource &resource) noexcept {
+    // GMP's default functions are malloc/realloc/free too, so limbs
+    // allocated outside the scope may safely be freed inside it and
+    // vice versa.
+    gmp_resource.store(&resource);
+    mp_set_memory_functions(gmp_allocate, gmp_reallocate, gmp_free);
+}
+
+GmpAllocationScope::~GmpAllocationScope() {
+    mp_set_memory_functions(nullptr, nullptr, nullptr);
+    gmp_resource.store(nullptr);
+}
+} // namespace inf
@@ -0,0 +1,111 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <charconv>
+#include <string_view>
+
+#include "env/options.hpp"
+#include "imr/error.hpp"
+
+namespace inf {
+namespace {
+unsigned parse_unsigned(std::string_view flag, std::string_view text) {
+    unsigned value = 0;
+    auto [end, errc] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (errc != std::errc{} || end != text.data() + text.size()) {
+        throw Error{std::string{flag} + " expects a number, got: " +
+                    std::string{text}};
+    }
+    return value;
+}
+} // namespace
+
+Options Options::parse(int argc, char const *const *argv) {
+    Options options;
+
+    for (int index = 1; index < argc; ++index) {
+        std::string_view argument{argv[index]};
+
+        auto value = [&]() -> std::string_view {
+            if (index + 1 >= argc) {
+                throw Error{std::string{argument} + " expects an argument"};
+            }
+            return argv[++index];
+        };
+
+        if (argument == "-o") {
+            options.output = value();
+        } else if (argument == "--lex-threads") {
+            options.lex_threads = parse_unsigned(argument, value());
+        } else if (argument == "-j") {
+            options.emit_threads = parse_unsigned(argument, value());
+        } else if (argument.starts_with("-O")) {
+            options.optimization_level =
+                parse_unsigned("-O", argument.substr(2));
+        } else if (argument == "--export") {
+            options.exports.emplace_back(value());
+        } else if (argument == "--no-mir") {
+            options.mir_passes = false;
+        } else if (argument == "--round") {
+            options.round = true;
+        } else if (argument == "--memory-report") {
+            options.memory_report = true;
+        } else if (argument == "--remarks") {
+            options.remarks = value();
+        } else if (argument == "--remarks-filter") {
+            options.remarks_filter = value();
+        } else if (argument == "--remarks-format") {
+            options.remarks_format = value();
+        } else if (argument == "--remarks-summary") {
+            options.remarks_summary = true;
+        } else if (argument == "--help" || argument == "-h") {
+            options.help = true;
+        } else if (argument.starts_with("-") && argument != "-") {
+            throw Error{"unknown option: " + std::string{argument}};
+        } else {
+            options.input = argument;
+        }
+    }
+
+    if (options.remarks_summary && options.remarks.empty()) {
+        throw Error{"--remarks-summary requires --remarks"};
+    }
+    return options;
+}
+
+std::string_view Options::usage() noexcept {
+    return "usage: inf [options] <file | ->\n"
+           "  -o <path>               write the object to path (a.o)\n"
+           "  -j <n>                  generate code on n threads, writing n\n"
+           "                          objects: path, then path with .1 to\n"
+           "                          .<n-1> inserted before its extension;\n"
+           "                          link all of them\n"
+           "  --lex-threads <n>       lex the input on n threads\n"
+           "  -O<n>                   optimization level (2)\n"
+           "  --export <name>         keep binding name, with external\n"
+           "                          linkage\n"
+           "  --no-mir                skip the optional MIR passes\n"
+           "  --round                 allow rounding inexact values\n"
+           "  --memory-report         print memory use by phase\n"
+           "  --remarks <path>        write LLVM optimization remarks\n"
+           "  --remarks-filter <re>   only remarks from passes matching re\n"
+           "  --remarks-format <fmt>  yaml or bitstream (yaml)\n"
+           "  --remarks-summary       print the remarks per statement\n"
+           "  -h, --help              print this and exit\n";
+}
+} // namespace inf
@@ -0,0 +1,142 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "boost/assert.hpp"
+
+#include "env/source_manager.hpp"
+#include "imr/error.hpp"
+
+namespace inf {
+Location SourceManager::add(std::unique_ptr<llvm::MemoryBuffer> buffer) {
+    if (streaming) {
+        throw Error::current("cannot add " +
+                             buffer->getBufferIdentifier().str() +
+                             " while a stream is open");
+    }
+
+    std::size_t size = buffer->getBufferSize();
+    if (size >= std::numeric_limits<std::uint32_t>::max() - next) {
+        throw Error::current("source address space exhausted by " +
+                             buffer->getBufferIdentifier().str());
+    }
+
+    Location base{next};
+    next += static_cast<std::uint32_t>(size) + 1;
+    files.emplace_back(
+        std::move(buffer), base, static_cast<std::uint32_t>(size));
+    return base;
+}
+
+Location SourceManager::add(std::string_view name, std::string_view text) {
+    return add(llvm::MemoryBuffer::getMemBufferCopy(
+        llvm::StringRef{text.data(), text.size()},
+        llvm::StringRef{name.data(), name.size()}));
+}
+
+Location SourceManager::open(std::string_view name) {
+    Location base = add(llvm::MemoryBuffer::getMemBuffer(
+        "", llvm::StringRef{name.data(), name.size()}));
+    File &file  = files.back();
+    file.extent = std::numeric_limits<std::uint32_t>::max() - base.offset();
+    file.line_starts.push_back(0);
+    streaming = true;
+    return base;
+}
+
+void SourceManager::close(Location                   base,
+                          std::uint32_t              size,
+                          std::vector<std::uint32_t> line_starts) {
+    BOOST_ASSERT(streaming && files.back().base == base);
+    File &file       = files.back();
+    file.extent      = size;
+    file.line_starts = std::move(line_starts);
+    if (file.line_starts.empty()) { file.line_starts.push_back(0); }
+    next      = base.offset() + size + 1;
+    streaming = false;
+}
+
+SourceManager::File const *
+SourceManager::file(Location location) const noexcept {
+    auto cursor = std::upper_bound(
+        files.begin(), files.end(), location, [](Location l, File const &f) {
+            return l < f.base;
+        });
+    if (cursor == files.begin()) { return nullptr; }
+
+    File const &file = *std::prev(cursor);
+    return file.contains(location) ? &file : nullptr;
+}
+
+std::string_view SourceManager::text(Location location) const noexcept {
+    File const *file = this->file(location);
+    if (file == nullptr) { return {}; }
+
+    std::string_view text   = file->text();
+    std::uint32_t    offset = location.offset() - file->base.offset();
+    if (offset > text.size()) { return {}; }
+    return text.substr(offset);
+}
+
+SourceManager::Presumed SourceManager::presume(Location location) const {
+    File const *file = this->file(location);
+    if (file == nullptr) { return {"<unknown>", 0, 0}; }
+
+    if (file->line_starts.empty()) {
+        std::string_view text  = file->text();
+        char const      *begin = text.data();
+        char const      *end   = begin + text.size();
+
+        file->line_starts.push_back(0);
+        for (char const *p = begin;
+             (p = static_cast<char const *>(
+                  std::memchr(p, '\n', static_cast<std::size_t>(end - p))));
+             ++p) {
+            file->line_starts.push_back(
+                static_cast<std::uint32_t>(p - begin + 1));
+        }
+    }
+
+    std::uint32_t offset = location.offset() - file->base.offset();
+    auto          line   = std::upper_bound(
+        file->line_starts.begin(), file->line_starts.end(), offset);
+    std::uint32_t start = *std::prev(line);
+
+    return {file->name(),
+            static_cast<std::uint32_t>(line - file->line_starts.begin()),
+            offset - start + 1};
+}
+
+void SourceManager::print(std::ostream &out, SourceRange range) const {
+    Presumed begin = presume(range.begin);
+    out << std::string_view{begin.file.data(), begin.file.size()} << ":"
+        << begin.line << "." << begin.column;
+
+    if (!range.end.valid() || range.end <= range.begin + 1) { return; }
+
+    // ranges are half open, print the last byte included.
+    Presumed end = presume(Location{range.end.offset() - 1});
+    if (end.line != begin.line) {
+        out << "-" << end.line << "." << end.column;
+    } else if (end.column != begin.column) {
+        out << "-" << end.column;
+    }
+}
+} // namespace inf
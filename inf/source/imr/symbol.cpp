@@ -0,0 +1,94 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <bit>
+
+#include "imr/error.hpp"
+#include "imr/symbol.hpp"
+
+namespace inf {
+void SymbolTable::grow(std::size_t capacity) {
+    std::vector<Slot> old = std::move(slots);
+    slots.assign(capacity, Slot{});
+    shift = 64 - std::countr_zero(capacity);
+    for (Slot const &slot : old) {
+        if (!slot.empty()) { *probe(slot.key) = slot; }
+    }
+}
+
+// backward shift deletion: later slots of the same probe sequence move up
+// into the hole, so no tombstones are left to lengthen future probes.
+void SymbolTable::erase(char const *key) noexcept {
+    std::size_t mask = slots.size() - 1;
+    auto        hole  = static_cast<std::size_t>(probe(key) - slots.data());
+    std::size_t index = (hole + 1) & mask;
+    while (!slots[index].empty()) {
+        // the slot may fill the hole only if the hole lies between its home
+        // and where it is now.
+        std::size_t home = this->home(slots[index].key);
+        if (((index - home) & mask) >= ((index - hole) & mask)) {
+            slots[hole] = slots[index];
+            hole        = index;
+        }
+        index = (index + 1) & mask;
+    }
+    slots[hole] = Slot{};
+    --count;
+}
+
+bool SymbolTable::bind(Label label, Symbol symbol) {
+    if ((count + 1) * 2 > slots.size()) { grow(slots.size() * 2); }
+
+    auto  depth = static_cast<std::uint32_t>(marks.size());
+    Slot *slot  = probe(label.data());
+    bool  fresh = slot->empty() || slot->depth() != depth;
+
+    // the outermost scope is never popped, so it needs no undo.
+    if (fresh && depth != 0) { log.push_back({label.data(), *slot}); }
+    if (slot->empty()) { ++count; }
+    *slot = {label.data(),
+             symbol.index,
+             depth << 8 | static_cast<std::uint32_t>(symbol.kind)};
+    return fresh;
+}
+
+void SymbolTable::push() {
+    // the depth must fit in the 24 bits of a slot's tag.
+    if (marks.size() >= 0xffffffu) {
+        throw Error::current("scopes nested too deeply");
+    }
+    marks.push_back(log.size());
+}
+
+void SymbolTable::pop() noexcept {
+    std::size_t mark = marks.back();
+    marks.pop_back();
+    for (; log.size() > mark; log.pop_back()) {
+        Undo const &undo = log.back();
+        if (undo.shadowed.empty()) {
+            erase(undo.key);
+        } else {
+            *probe(undo.key) = undo.shadowed;
+        }
+    }
+}
+
+void SymbolTable::reserve(std::size_t size) {
+    std::size_t capacity = std::bit_ceil(size * 2);
+    if (capacity > slots.size()) { grow(capacity); }
+}
+} // namespace inf
@@ -17,13 +17,151 @@
 
 #include <iostream>
 #include <exception>
+#include <optional>
 
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+
+#include "core/codegen.hpp"
+#include "core/emit.hpp"
+#include "core/lower.hpp"
+#include "core/optimize.hpp"
+#include "core/parser.hpp"
+#include "core/passes.hpp"
+#include "core/reachable.hpp"
+#include "core/remarks.hpp"
+#include "core/tokenize.hpp"
+#include "env/context.hpp"
+#include "env/memory.hpp"
+#include "env/options.hpp"
 #include "support/config.hpp"
 
-int main() {
+// print every error recorded so far, returning true if there were any.
+static bool report_errors(inf::Context const &context) {
+    for (inf::Error const &error : context.errors()) {
+        context.sources().print(std::cerr, error.range());
+        std::cerr << ": " << error.message() << "\n";
+    }
+    return !context.errors().empty();
+}
+
+// read whatever stdin has available, without waiting to fill data.
+static std::size_t read_stdin(char *data, std::size_t size) {
+    llvm::Expected<std::size_t> read =
+        llvm::sys::fs::readNativeFile(llvm::sys::fs::getStdinHandle(),
+                                      llvm::MutableArrayRef<char>{data, size});
+    if (!read) { throw inf::Error{"<stdin>: " + toString(read.takeError())}; }
+    return *read;
+}
+
+int main(int argc, char **argv) {
     try {
-        std::cout << INF_VERSION_STRING << std::endl;
+        inf::Options options = inf::Options::parse(argc, argv);
+        if (options.help) {
+            std::cout << inf::Options::usage();
+            return 0;
+        }
+        if (options.input.empty()) {
+            std::cout << INF_VERSION_STRING << std::endl;
+            return 0;
+        }
+
+        inf::Context                           context{options.input};
+        inf::TrackingResource                 &memory = context.memory();
+        std::optional<inf::GmpAllocationScope> gmp_scope;
+        if (options.memory_report) { gmp_scope.emplace(memory); }
+
+        bool streaming = options.input == "-" && options.lex_threads <= 1;
+        inf::Location source;
+        if (streaming) {
+            source = context.sources().open("<stdin>");
+        } else {
+            auto file = llvm::MemoryBuffer::getFileOrSTDIN(options.input);
+            if (!file) {
+                throw inf::Error{options.input + ": " +
+                                 file.getError().message()};
+            }
+            source = context.sources().add(std::move(*file));
+        }
+
+        std::optional<inf::Remarks> remarks;
+        if (!options.remarks.empty()) {
+            remarks.emplace(context,
+                            options.remarks,
+                            options.remarks_filter,
+                            options.remarks_format);
+        }
+
+        {
+            // the ast lives in the arena until it has been lowered.
+            inf::Arena                 arena{&memory};
+            std::vector<inf::Ast::Ptr> statements;
+            {
+                inf::PhaseScope               phase{memory, inf::Phase::Parse};
+                yy::Lexer                     lexer{&context};
+                std::vector<yy::Lexer::Token> tokens;
+                if (options.lex_threads > 1) {
+                    tokens =
+                        inf::tokenize(context, source, options.lex_threads);
+                    lexer.set_tokens(tokens);
+                } else if (streaming) {
+                    lexer.set_stream(read_stdin, source);
+                } else {
+                    lexer.set_view(context.sources().text(source), source);
+                }
+                // only the parser allocates nodes, on this thread alone.
+                context.ast_memory(&arena);
+                yy::Parser parser{&lexer, &context, &statements};
+                bool       failed = parser.parse() != 0;
+                context.ast_memory(&memory);
+                if (streaming) { lexer.close(); }
+                if (report_errors(context) || failed) { return 1; }
+            }
+
+            inf::PhaseScope phase{memory, inf::Phase::Lower};
+            std::vector<inf::Label> exports;
+            exports.reserve(options.exports.size());
+            for (std::string const &name : options.exports) {
+                exports.push_back(context.intern_string(name));
+            }
+            // bindings nothing needs are never lowered at all.
+            inf::retain_reachable(context, statements, exports);
+            inf::mir::Module module =
+                inf::lower(context, statements, {}, exports);
+            statements.clear();
+            if (report_errors(context)) { return 1; }
+
+            if (options.mir_passes) {
+                inf::mir::optimize(module);
+            } else {
+                inf::mir::fold_constants(module);
+            }
+            inf::codegen(context,
+                         module,
+                         {.round      = options.round,
+                          .debug_info = remarks.has_value()});
+            if (report_errors(context)) { return 1; }
+        }
+
+        {
+            inf::PhaseScope phase{memory, inf::Phase::Optimize};
+            inf::optimize(context, options.optimization_level);
+        }
+
+        {
+            inf::PhaseScope phase{memory, inf::Phase::Emit};
+            std::vector<inf::ObjectBuffer> objects =
+                inf::emit_objects(context, options.emit_threads);
+            inf::write_objects(options.output, objects);
+        }
+
+        if (remarks) {
+            remarks->finish();
+            if (options.remarks_summary) { remarks->summarize(std::cerr); }
+        }
+        if (options.memory_report) { memory.report(std::cerr); }
     } catch (std::exception const &e) {
         std::cerr << e.what() << "\n";
+        return 1;
     }
 }
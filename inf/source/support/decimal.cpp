@@ -0,0 +1,126 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <tmmintrin.h>
+#endif
+
+#include "support/decimal.hpp"
+
+namespace inf {
+namespace {
+// the most digits which always fit in a 64 bit word.
+constexpr std::size_t word_digits = 19;
+
+constexpr std::uint64_t power10(std::size_t exponent) {
+    std::uint64_t result = 1;
+    while (exponent-- > 0) {
+        result *= 10;
+    }
+    return result;
+}
+
+#if defined(__x86_64__)
+// every x86-64 has sse2, but the byte multiply parse16 rests on is ssse3,
+// so it is compiled for ssse3 alone and chosen at runtime.
+bool const has_ssse3 = __builtin_cpu_supports("ssse3");
+
+// sixteen digits at p, combined pairwise into 2, 4 and then 8 digit lanes.
+__attribute__((target("ssse3"))) std::uint64_t parse16(char const *p) {
+    __m128i chunk = _mm_sub_epi8(
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(p)),
+        _mm_set1_epi8('0'));
+    __m128i pairs = _mm_maddubs_epi16(
+        chunk,
+        _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+    __m128i quads = _mm_madd_epi16(
+        pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+    quads          = _mm_packs_epi32(quads, quads);
+    __m128i octets = _mm_madd_epi16(
+        quads, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+
+    auto high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(octets));
+    auto low  = static_cast<std::uint32_t>(
+        _mm_cvtsi128_si32(_mm_srli_si128(octets, 4)));
+    return std::uint64_t{high} * power10(8) + low;
+}
+#endif
+
+// eight digits at p, combined pairwise within a single word.
+std::uint64_t parse8(char const *p) {
+    if constexpr (std::endian::native != std::endian::little) {
+        std::uint64_t result = 0;
+        for (std::size_t index = 0; index < 8; ++index) {
+            result = result * 10 + static_cast<std::uint64_t>(p[index] - '0');
+        }
+        return result;
+    }
+
+    std::uint64_t word;
+    std::memcpy(&word, p, sizeof(word));
+    word -= 0x3030303030303030;
+    word = (word * 10) + (word >> 8);
+    return (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+           32;
+}
+
+// at most word_digits digits.
+std::uint64_t parse_word(char const *p, std::size_t length) {
+    std::uint64_t result = 0;
+#if defined(__x86_64__)
+    if (length >= 16 && has_ssse3) {
+        result = parse16(p);
+        p += 16;
+        length -= 16;
+    }
+#endif
+    while (length >= 8) {
+        result = result * power10(8) + parse8(p);
+        p += 8;
+        length -= 8;
+    }
+    while (length-- > 0) {
+        result = result * 10 + static_cast<std::uint64_t>(*p++ - '0');
+    }
+    return result;
+}
+} // namespace
+
+Integer parse_integer(std::string_view digits) {
+    if (digits.size() <= word_digits) {
+        return Integer{parse_word(digits.data(), digits.size())};
+    }
+
+    // the leading chunk takes the remainder, so every later one is full.
+    std::size_t first = digits.size() % word_digits;
+    if (first == 0) { first = word_digits; }
+
+    Integer result{parse_word(digits.data(), first)};
+    mpz_ptr limbs = result.backend().data();
+    for (std::size_t index = first; index < digits.size();
+         index += word_digits) {
+        mpz_mul_ui(limbs, limbs, power10(word_digits));
+        mpz_add_ui(limbs, limbs, parse_word(digits.data() + index, word_digits));
+    }
+    return result;
+}
+} // namespace inf
@@ -0,0 +1,58 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <random>
+#include <string>
+
+#include "boost/test/unit_test.hpp"
+
+#include "support/decimal.hpp"
+
+BOOST_AUTO_TEST_CASE ( decimal )
+{
+    // either side of every chunk boundary, and of 2^64.
+    for (std::string digits : {"0",
+                               "7",
+                               "12345678",
+                               "123456789",
+                               "1234567890123456",
+                               "12345678901234567",
+                               "9999999999999999999",
+                               "10000000000000000000",
+                               "18446744073709551615",
+                               "18446744073709551616",
+                               "99999999999999999999999999999999999999",
+                               "100000000000000000000000000000000000000"}) {
+        BOOST_TEST(inf::parse_integer(digits) == inf::Integer{digits},
+                   digits);
+    }
+
+    // leading zeros are decimal, not octal.
+    BOOST_TEST(inf::parse_integer("0010") == 10);
+    BOOST_TEST(inf::parse_integer("00000000000000000000000042") == 42);
+
+    std::mt19937 random{2024};
+    for (unsigned count = 0; count < 10000; ++count) {
+        std::size_t length = 1 + random() % 80;
+        std::string digits(1, static_cast<char>('1' + random() % 9));
+        while (digits.size() < length) {
+            digits.push_back(static_cast<char>('0' + random() % 10));
+        }
+        BOOST_TEST(inf::parse_integer(digits) == inf::Integer{digits},
+                   digits);
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string>
+
+#include "llvm/IR/Function.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/emit.hpp"
+
+BOOST_AUTO_TEST_CASE ( emit )
+{
+    BOOST_TEST(inf::object_path("out.o", 0) == "out.o");
+    BOOST_TEST(inf::object_path("out.o", 2) == "out.2.o");
+    BOOST_TEST(inf::object_path("out", 1) == "out.1");
+
+    inf::Context        context{"emit"};
+    llvm::IRBuilder<>  &builder = context.builder();
+    llvm::Type         *i64     = builder.getInt64Ty();
+    llvm::FunctionType *type =
+        llvm::FunctionType::get(i64, {i64}, /* isVarArg = */ false);
+    for (unsigned index = 0; index < 8; ++index) {
+        llvm::Function *function =
+            llvm::Function::Create(type,
+                                   llvm::Function::ExternalLinkage,
+                                   "f" + std::to_string(index),
+                                   context.module());
+        builder.SetInsertPoint(
+            llvm::BasicBlock::Create(context.ir_context(), "entry", function));
+        builder.CreateRet(
+            builder.CreateMul(function->getArg(0), builder.getInt64(index)));
+    }
+
+    // -j 3 writes three objects, each of them a whole object file.
+    llvm::SmallString<128> directory;
+    BOOST_REQUIRE(!llvm::sys::fs::createUniqueDirectory("inf-emit", directory));
+    llvm::SmallString<128> path{directory};
+    llvm::sys::path::append(path, "out.o");
+
+    auto objects = inf::emit_objects(context, 3);
+    BOOST_REQUIRE(objects.size() == 3u);
+    inf::write_objects(path.str(), objects);
+    for (std::size_t index = 0; index < objects.size(); ++index) {
+        std::string file   = inf::object_path(path.str(), index);
+        auto        buffer = llvm::MemoryBuffer::getFile(file);
+        BOOST_REQUIRE(static_cast<bool>(buffer));
+        BOOST_TEST((*buffer)->getBuffer() ==
+                       llvm::StringRef(objects[index].data(),
+                                       objects[index].size()),
+                   file);
+        BOOST_TEST(!(*buffer)->getBuffer().empty());
+        llvm::sys::fs::remove(file);
+    }
+    BOOST_TEST(!llvm::sys::fs::exists(inf::object_path(path.str(), 3)));
+    llvm::sys::fs::remove(directory);
+}
@@ -0,0 +1,216 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/interpret.hpp"
+#include "core/passes.hpp"
+
+#include "parse.hpp"
+
+// text over the parameters x and y, which must lower without errors.
+static inf::mir::Module
+build(inf::Context &context, std::string_view text, bool optimize) {
+    inf::Label const parameters[] = {context.intern_string("x"),
+                                     context.intern_string("y")};
+    inf::mir::Module module = lower(context, text, parameters);
+    BOOST_REQUIRE(context.errors().empty());
+    if (optimize) { inf::mir::optimize(module); }
+    return module;
+}
+
+// a random expression over x, y and earlier bindings, with its value
+// computed directly, or nothing once the value could overflow.
+struct Generator {
+    std::mt19937_64           random{20260119};
+    std::int64_t              x = 0;
+    std::int64_t              y = 0;
+    std::vector<std::int64_t> bindings;
+
+    std::optional<std::int64_t> checked(__int128 value) const {
+        if (value < -(__int128{1} << 40) || value > (__int128{1} << 40)) {
+            return std::nullopt;
+        }
+        return static_cast<std::int64_t>(value);
+    }
+
+    std::optional<std::int64_t> leaf(std::string &text, bool constant) {
+        std::size_t choice = random() % (constant ? 2 : 4);
+        if (choice == 0 || bindings.empty()) {
+            auto value = static_cast<std::int64_t>(random() % 10);
+            text += std::to_string(value);
+            return value;
+        }
+        if (choice == 1) {
+            std::size_t index = random() % bindings.size();
+            text += "b" + std::to_string(index);
+            return bindings[index];
+        }
+        text += choice == 2 ? "-x" : "y";
+        return choice == 2 ? -x : y;
+    }
+
+    std::optional<std::int64_t>
+    expression(std::string &text, unsigned depth, bool constant) {
+        if (depth == 0 || random() % 4 == 0) { return leaf(text, constant); }
+
+        char op = "+-*%"[random() % 4];
+        text += "(";
+        std::optional<std::int64_t> a = expression(text, depth - 1, constant);
+        text += std::string{" "} + op + " ";
+        std::optional<std::int64_t> b;
+        if (op == '%') {
+            b = static_cast<std::int64_t>(random() % 9 + 1);
+            text += std::to_string(*b);
+        } else {
+            b = expression(text, depth - 1, constant);
+        }
+        text += ")";
+        if (!a || !b) { return std::nullopt; }
+
+        switch (op) {
+        case '+': return checked(__int128{*a} + *b);
+        case '-': return checked(__int128{*a} - *b);
+        case '*': return checked(__int128{*a} * *b);
+        default:  return *a % *b;
+        }
+    }
+};
+
+BOOST_AUTO_TEST_CASE ( interpret )
+{
+    std::int64_t const arguments[] = {7, -3};
+
+    {
+        inf::Context           context{"interpret"};
+        inf::mir::Module       module =
+            build(context, "a = 10; x * a + y % 7;", true);
+        inf::bytecode::Program program = inf::assemble(context, module);
+        BOOST_REQUIRE(context.errors().empty());
+        BOOST_TEST(inf::interpret(program, arguments) == 67);
+        BOOST_CHECK_THROW(inf::interpret(program, {}), inf::Error);
+    }
+
+    // the same expressions evaluate alike however they were optimized, and
+    // as computed directly: unoptimized, bindings are calls and every
+    // operation is checked.
+    Generator generator;
+    for (std::size_t round = 0; round < 500; ++round) {
+        generator.bindings.clear();
+        generator.x = static_cast<std::int64_t>(generator.random() % 2001) -
+                      1000;
+        generator.y = static_cast<std::int64_t>(generator.random() % 2001) -
+                      1000;
+
+        std::string text;
+        bool        valid = true;
+        for (std::size_t index = 0; index < 4 && valid; ++index) {
+            text += "b" + std::to_string(index) + " = ";
+            std::optional<std::int64_t> value =
+                generator.expression(text, 3, true);
+            text += ";\n";
+            valid = value.has_value();
+            if (value) { generator.bindings.push_back(*value); }
+        }
+        std::optional<std::int64_t> expected =
+            generator.expression(text, 4, false);
+        text += ";\n";
+        if (!valid || !expected) { continue; }
+
+        std::int64_t const values[] = {generator.x, generator.y};
+        for (bool optimize : {false, true}) {
+            inf::Context           context{"interpret"};
+            inf::mir::Module       module  = build(context, text, optimize);
+            inf::bytecode::Program program = inf::assemble(context, module);
+            BOOST_REQUIRE(context.errors().empty());
+            BOOST_TEST(inf::interpret(program, values) == *expected, text);
+        }
+    }
+
+    // more registers than fit on the interpreter's stack.
+    {
+        std::string text = "x";
+        for (std::size_t index = 0; index < 300; ++index) {
+            text += " + x";
+        }
+        text += ";";
+        inf::Context           context{"interpret"};
+        inf::mir::Module       module  = build(context, text, false);
+        inf::bytecode::Program program = inf::assemble(context, module);
+        BOOST_TEST(program.functions[program.entry].registers > 128u);
+        BOOST_TEST(inf::interpret(program, arguments) == 301 * 7);
+    }
+
+    // constants and quotients follow codegen's rules.
+    {
+        inf::Context           context{"interpret"};
+        inf::mir::Module       module  = build(context, "1 / 4;", true);
+        inf::bytecode::Program program = inf::assemble(context, module);
+        BOOST_REQUIRE(context.errors().empty());
+        BOOST_TEST(program.returns_double);
+        BOOST_TEST(program.real == 0.25);
+        BOOST_CHECK_THROW(inf::interpret(program, arguments), inf::Error);
+    }
+    for (bool round : {false, true}) {
+        inf::Context           context{"interpret"};
+        inf::mir::Module       module  = build(context, "x / y;", true);
+        inf::bytecode::Program program = inf::assemble(context, module, round);
+        BOOST_TEST(context.errors().size() == (round ? 0u : 1u));
+        if (round) { BOOST_TEST(inf::interpret(program, arguments) == -2); }
+    }
+
+    // INT64_MIN % -1 is 0, as in the JIT, whether or not the ranges prove
+    // the divisor cannot be -1.
+    constexpr auto min = std::numeric_limits<std::int64_t>::min();
+    struct Case {
+        char const  *text;
+        std::int64_t x;
+        std::int64_t y;
+        std::int64_t expected;
+    };
+    for (Case const &c : {Case{"x % y;", min, -1, 0},
+                          Case{"x % y;", 7, -1, 0},
+                          Case{"x % y;", -7, 4, -3},
+                          Case{"x % (y % 2 - 2);", min, 1, 0},
+                          Case{"x % (y % 2 - 2);", -7, 0, -1},
+                          Case{"(x % 10) % y;", min, -1, 0}}) {
+        for (bool optimize : {false, true}) {
+            std::int64_t const     values[] = {c.x, c.y};
+            inf::Context           context{"interpret"};
+            inf::mir::Module       module  = build(context, c.text, optimize);
+            inf::bytecode::Program program = inf::assemble(context, module);
+            BOOST_REQUIRE(context.errors().empty());
+            BOOST_TEST(inf::interpret(program, values) == c.expected, c.text);
+        }
+    }
+
+    {
+        inf::Context     context{"interpret"};
+        inf::mir::Module module =
+            build(context, "x + 9223372036854775808;", true);
+        inf::assemble(context, module);
+        BOOST_TEST(context.errors().size() == 1u);
+    }
+}
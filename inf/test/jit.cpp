@@ -0,0 +1,294 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "llvm/Support/Process.h"
+
+#include "boost/test/unit_test.hpp"
+
+#include "api/inf.h"
+#include "api/jit.hpp"
+
+BOOST_AUTO_TEST_CASE ( jit )
+{
+    using Binary = std::int64_t(std::int64_t, std::int64_t);
+    std::array<std::string_view, 2> xy{"x", "y"};
+
+    {
+        inf::Expression expression =
+            inf::compile("a = 10; x * a + y % 7", xy);
+        Binary *f = expression.function<Binary>();
+        BOOST_TEST(f(2, 3) == 23);
+        BOOST_TEST(f(-2, 10) == -17);
+
+        // the code is pure, so concurrent calls need no synchronization.
+        std::vector<std::jthread> threads;
+        std::array<bool, 8>       results{};
+        for (std::size_t index = 0; index < results.size(); ++index) {
+            threads.emplace_back([f, &result = results[index], index]() {
+                auto i = static_cast<std::int64_t>(index);
+                result = true;
+                for (std::int64_t x = -1000; x < 1000; ++x) {
+                    result = result && f(x, i) == x * 10 + i % 7;
+                }
+            });
+        }
+        threads.clear();
+        for (bool result : results) {
+            BOOST_TEST(result);
+        }
+
+        BOOST_CHECK_THROW(expression.function<std::int64_t(std::int64_t)>(),
+                          inf::Error);
+        BOOST_CHECK_THROW(expression.function<double(std::int64_t,
+                                                     std::int64_t)>(),
+                          inf::Error);
+    }
+
+    // a parameter shadows a binding, and is not in scope in bindings.
+    {
+        std::array<std::string_view, 1> a{"a"};
+        inf::Expression expression = inf::compile("a = 1; a + 1;", a);
+        BOOST_TEST(expression.function<std::int64_t(std::int64_t)>()(5) == 6);
+        BOOST_CHECK_THROW(inf::compile("b = a; b", a), inf::Error);
+    }
+
+    {
+        inf::Expression expression = inf::compile("1 / 4", {});
+        BOOST_TEST(expression.returns_double());
+        BOOST_TEST(expression.function<double()>()() == 0.25);
+    }
+
+    // INT64_MIN % -1 is 0, however the remainder was proven; here the
+    // divisor is either unknown, or never zero but possibly -1.
+    {
+        auto            min = std::numeric_limits<std::int64_t>::min();
+        inf::Expression any = inf::compile("x % y", xy);
+        Binary         *f   = any.function<Binary>();
+        BOOST_TEST(f(min, -1) == 0);
+        BOOST_TEST(f(7, -1) == 0);
+        BOOST_TEST(f(-7, 4) == -3);
+
+        inf::Expression nonzero = inf::compile("x % (y % 2 - 2)", xy);
+        Binary         *g       = nonzero.function<Binary>();
+        BOOST_TEST(g(min, 1) == 0);
+        BOOST_TEST(g(-7, 0) == -1);
+        BOOST_TEST(g(8, 2) == 0);
+    }
+
+    BOOST_CHECK_THROW(inf::compile("x / y", xy), inf::Error);
+    {
+        inf::Expression expression =
+            inf::compile("x / y", xy, {.optimization_level = 2, .round = true});
+        BOOST_TEST(expression.function<Binary>()(7, -2) == -3);
+    }
+
+    // profilers see each function under the statement it came from.
+    {
+        inf::Expression expression = inf::compile(
+            "x * 3 + y", xy, {.name = "profiled", .perf = true, .gdb = true});
+        BOOST_TEST(expression.function<Binary>()(2, 1) == 7);
+
+        std::ifstream map{"/tmp/perf-" +
+                          std::to_string(llvm::sys::Process::getProcessId()) +
+                          ".map"};
+        bool          found = false;
+        for (std::string line; std::getline(map, line);) {
+            found = found || line.ends_with(" entry.0@profiled:1.1");
+        }
+        BOOST_TEST(found);
+    }
+
+    BOOST_CHECK_THROW(inf::compile("x + z", xy), inf::Error);
+    BOOST_CHECK_THROW(inf::compile("x; y", xy), inf::Error);
+    BOOST_CHECK_THROW(inf::compile("x +", xy), inf::Error);
+
+    // a library compiles each binding the first time it is called.
+    {
+        inf::Library library = inf::load(
+            "a = 20; b = a * 2 + 2; a = 1; c = a + b; d = c * c;");
+        BOOST_TEST(library.contains("d"));
+        BOOST_TEST(!library.contains("x"));
+        BOOST_TEST(library.function("b")() == 42);
+        BOOST_TEST(library.function("c")() == 43);
+        BOOST_TEST(library.function("a")() == 1);
+        BOOST_CHECK_THROW(library.function("x"), inf::Error);
+
+        // pure, so concurrent first calls need no synchronization either.
+        inf::Library wide = inf::load("p = 6; q = p * 7; r = q - p;");
+        std::vector<std::jthread> threads;
+        std::array<bool, 8>       results{};
+        for (bool &result : results) {
+            threads.emplace_back([&wide, &result]() {
+                result = wide.function("r")() == 36 &&
+                         wide.function("q")() == 42;
+            });
+        }
+        threads.clear();
+        for (bool result : results) {
+            BOOST_TEST(result);
+        }
+
+        BOOST_CHECK_THROW(inf::load("a = 1; a + 1"), inf::Error);
+        BOOST_CHECK_THROW(inf::load("a = b"), inf::Error);
+    }
+
+    // tiered expressions are interpreted until hot, then run natively.
+    {
+        std::array<std::int64_t, 2> arguments{2, 3};
+        inf::Tiered interpreted = inf::prepare(
+            "a = 10; x * a + y % 7", xy, {.promote_after = inf::Tiered::never});
+        for (std::size_t index = 0; index < 100; ++index) {
+            BOOST_TEST(interpreted.evaluate(arguments) == 23);
+        }
+        BOOST_TEST(!interpreted.native());
+        BOOST_CHECK_THROW(interpreted.evaluate({}), inf::Error);
+
+        // evaluations carry on while the compile runs, and switch over.
+        inf::Tiered tiered = inf::prepare(
+            "a = 10; x * a + y % 7", xy, {.promote_after = 10});
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::seconds{60};
+        std::vector<std::jthread> threads;
+        std::array<bool, 4>       results{};
+        for (std::size_t index = 0; index < results.size(); ++index) {
+            threads.emplace_back([&, &result = results[index], index]() {
+                auto y = static_cast<std::int64_t>(index);
+                result = true;
+                do {
+                    for (std::int64_t x = -100; x < 100; ++x) {
+                        std::array<std::int64_t, 2> pair{x, y};
+                        result = result &&
+                                 tiered.evaluate(pair) == x * 10 + y % 7;
+                    }
+                } while (!tiered.native() &&
+                         std::chrono::steady_clock::now() < deadline);
+            });
+        }
+        threads.clear();
+        for (bool result : results) {
+            BOOST_TEST(result);
+        }
+        BOOST_TEST(tiered.native());
+        BOOST_TEST(tiered.evaluate(arguments) == 23);
+
+        // constants have nothing to gain from compiling.
+        inf::Tiered constant = inf::prepare("2 * 21", {}, {.promote_after = 0});
+        BOOST_TEST(constant.evaluate({}) == 42);
+        BOOST_TEST(!constant.native());
+
+        inf::Tiered real = inf::prepare("1 / 4", {});
+        BOOST_TEST(real.returns_double());
+        BOOST_TEST(real.real() == 0.25);
+        BOOST_CHECK_THROW(real.evaluate({}), inf::Error);
+
+        BOOST_CHECK_THROW(inf::prepare("x + z", xy), inf::Error);
+        BOOST_CHECK_THROW(inf::prepare("x / y", xy), inf::Error);
+
+        // both tiers agree on remainders by -1, proven or not.
+        auto min = std::numeric_limits<std::int64_t>::min();
+        for (char const *source : {"x % y", "x % (y % 2 - 2)"}) {
+            inf::Tiered slow =
+                inf::prepare(source, xy, {.promote_after = inf::Tiered::never});
+            inf::Tiered fast = inf::prepare(source, xy, {.promote_after = 0});
+            while (!fast.native() &&
+                   std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            BOOST_TEST(fast.native());
+            for (std::array<std::int64_t, 2> pair :
+                 {std::array<std::int64_t, 2>{min, -1},
+                  std::array<std::int64_t, 2>{min, 1},
+                  std::array<std::int64_t, 2>{-7, 3}}) {
+                BOOST_TEST(slow.evaluate(pair) == fast.evaluate(pair), source);
+            }
+        }
+    }
+
+    // checked expressions report what would otherwise trap.
+    {
+        auto            min      = std::numeric_limits<std::int64_t>::min();
+        inf::Expression quotient =
+            inf::compile("x / y", xy, {.round = true, .checked = true});
+
+        std::int32_t                fault = 1;
+        std::array<std::int64_t, 2> pair{7, 2};
+        BOOST_TEST(quotient.checked()(pair.data(), &fault) == 3);
+        BOOST_TEST(fault == 0);
+        for (std::array<std::int64_t, 2> bad :
+             {std::array<std::int64_t, 2>{1, 0},
+              std::array<std::int64_t, 2>{min, -1}}) {
+            BOOST_TEST(quotient.checked()(bad.data(), &fault) == 0);
+            BOOST_TEST(fault == 1);
+        }
+        BOOST_CHECK_THROW(quotient.function<Binary>(), inf::Error);
+        BOOST_CHECK_THROW(quotient.packed(), inf::Error);
+
+        // a binding which always divides by zero never gets to run.
+        BOOST_CHECK_THROW(
+            inf::compile("a = 1 % 0; x % (a + 1)", xy, {.checked = true}),
+            inf::Error);
+
+        BOOST_CHECK_THROW(inf::compile("x + y", xy).checked(), inf::Error);
+    }
+
+    // the C interface.
+    {
+        char const *names[] = {"x", "y"};
+        char       *error   = nullptr;
+        inf_expression *expression =
+            inf_compile("x - y", names, 2, nullptr, &error);
+        BOOST_REQUIRE(expression != nullptr);
+        BOOST_TEST(inf_expression_arity(expression) == 2u);
+        BOOST_TEST(!inf_expression_returns_double(expression));
+        auto f = reinterpret_cast<Binary *>(inf_expression_address(expression));
+        BOOST_TEST(f(10, 4) == 6);
+        std::int64_t const arguments[] = {10, 4};
+        std::int64_t       result      = 0;
+        BOOST_TEST(inf_expression_evaluate(expression, arguments, &result) ==
+                   INF_UNCHECKED);
+        inf_expression_release(expression);
+
+        inf_jit_options options = inf_jit_options_default();
+        options.round           = 1;
+        options.checked         = 1;
+        expression = inf_compile("x / y", names, 2, &options, &error);
+        BOOST_REQUIRE(expression != nullptr);
+        BOOST_TEST(inf_expression_evaluate(expression, arguments, &result) ==
+                   INF_OK);
+        BOOST_TEST(result == 2);
+        std::int64_t const zero[] = {10, 0};
+        BOOST_TEST(inf_expression_evaluate(expression, zero, &result) ==
+                   INF_FAULT);
+        BOOST_TEST(result == 2);
+        inf_expression_release(expression);
+
+        BOOST_TEST(inf_compile("x - z", names, 2, nullptr, &error) == nullptr);
+        BOOST_REQUIRE(error != nullptr);
+        BOOST_TEST(std::string_view{error}.find("unknown binding: z") !=
+                   std::string_view::npos);
+        inf_error_release(error);
+    }
+}
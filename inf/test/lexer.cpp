@@ -39,4 +39,28 @@ BOOST_AUTO_TEST_CASE ( lexer )
     BOOST_TEST(tokenize(lexer, yy::Lexer::Token::Percent{}, "%"));
     BOOST_TEST(tokenize(lexer, inf::Integer{0}, "0"));
     BOOST_TEST(tokenize(lexer, inf::Integer{778932789523}, "778932789523"));
+
+    // exponents too large in either direction are errors, however far
+    // beyond an int they go.
+    for (std::string_view text : {"1.5e-2147483648",
+                                  "1.5e-9223372036854775808",
+                                  "1e2147483647",
+                                  "1e99999999999999999999",
+                                  "1e-4097",
+                                  "1e4097"}) {
+        inf::Context context{"lexer"};
+        yy::Lexer    decimal{&context};
+        decimal.set_view(text);
+        BOOST_TEST(decimal.advance().is<yy::Lexer::Token::Error>(), text);
+        BOOST_TEST(context.errors().size() == 1u, text);
+    }
+    BOOST_TEST(tokenize(lexer, inf::Rational(1, 10), "1e-1"));
+
+    lexer.set_view("  42;", inf::Location{10});
+    yy::Lexer::Token integer = lexer.advance();
+    BOOST_TEST((integer.range ==
+                inf::SourceRange{inf::Location{12}, inf::Location{14}}));
+    yy::Lexer::Token semicolon = lexer.advance();
+    BOOST_TEST((semicolon.range ==
+                inf::SourceRange{inf::Location{14}, inf::Location{15}}));
 }
@@ -0,0 +1,75 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#include <optional>
+
+#include "boost/test/unit_test.hpp"
+
+#include "env/memory.hpp"
+#include "imr/number.hpp"
+
+BOOST_AUTO_TEST_CASE ( memory )
+{
+    inf::TrackingResource resource;
+    {
+        inf::PhaseScope scope{resource, inf::Phase::Parse};
+        std::pmr::vector<int> ints{&resource};
+        ints.resize(256);
+        BOOST_TEST(resource.live() >= 256 * sizeof(int));
+    }
+    BOOST_TEST(resource.phase() == inf::Phase::Setup);
+    BOOST_TEST(resource.live() == 0u);
+
+    inf::AllocationStats parse = resource.stats(inf::Phase::Parse);
+    BOOST_TEST(parse.allocations == 1u);
+    BOOST_TEST(parse.deallocations == 1u);
+    BOOST_TEST(parse.allocated_bytes == parse.deallocated_bytes);
+    BOOST_TEST(parse.peak_bytes >= 256 * sizeof(int));
+    BOOST_TEST(resource.stats(inf::Phase::Emit).allocations == 0u);
+
+    {
+        inf::PhaseScope scope{resource, inf::Phase::Emit};
+        inf::Arena      arena{&resource};
+        for (int i = 0; i < 64; ++i) {
+            arena.allocate(16, alignof(std::max_align_t));
+        }
+        BOOST_TEST(resource.stats(inf::Phase::Emit).allocations <= 2u);
+    }
+    BOOST_TEST(resource.live() == 0u);
+
+    // limbs allocated before GMP's hooks are installed, and freed after,
+    // never take the live count below zero.
+    {
+        inf::TrackingResource       gmp;
+        std::optional<inf::Integer> early{inf::Integer{1} << 4096};
+        {
+            inf::GmpAllocationScope scope{gmp};
+            early.reset();
+            BOOST_TEST(gmp.live() == 0u);
+            inf::Integer late = inf::Integer{1} << 4096;
+            BOOST_TEST(gmp.live() >= 4096u / 8);
+        }
+        BOOST_TEST(gmp.live() == 0u);
+    }
+    {
+        inf::TrackingResource resource;
+        resource.record_allocation(8);
+        resource.record_deallocation(64);
+        BOOST_TEST(resource.live() == 0u);
+        resource.record_allocation(16);
+        BOOST_TEST(resource.live() == 16u);
+    }
+}
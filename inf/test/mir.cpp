@@ -0,0 +1,141 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#include "boost/test/unit_test.hpp"
+
+#include "core/passes.hpp"
+
+#include "parse.hpp"
+
+static inf::mir::Value append(inf::mir::Function &function,
+                              inf::mir::Opcode    opcode,
+                              inf::mir::Value     a = 0,
+                              inf::mir::Value     b = 0) {
+    return function.append({opcode, 0, a, b}, {});
+}
+
+BOOST_AUTO_TEST_CASE ( mir )
+{
+    using inf::mir::Instruction;
+    using inf::mir::Opcode;
+
+    // bindings fold through calls, and unreachable ones disappear.
+    {
+        inf::Context     context{"mir"};
+        inf::mir::Module module =
+            lower(context, "a = 2 * 3; b = a + 1; c = 100; b * 2;");
+        BOOST_REQUIRE(context.errors().empty());
+        BOOST_TEST(module.functions.size() == 4u);
+
+        inf::mir::optimize(module);
+        BOOST_REQUIRE(module.functions.size() == 1u);
+        inf::mir::Function const &entry = module.functions.front();
+        BOOST_TEST(entry.entry);
+        BOOST_REQUIRE(entry.instructions.size() == 1u);
+        BOOST_TEST((entry.instructions[0].opcode == Opcode::Constant));
+        BOOST_TEST(module.constants[entry.instructions[0].a] == 14);
+    }
+
+    {
+        inf::Context context{"mir"};
+        lower(context, "a = b;");
+        BOOST_TEST(context.errors().size() == 1u);
+    }
+
+    // (p % 10) * (p % 10) computes the remainder once, and the product
+    // provably fits in 64 bits while p * p does not.
+    {
+        inf::mir::Module   module;
+        inf::mir::Function function{};
+        function.entry      = true;
+        function.parameters = 1;
+        module.constants.emplace_back(10);
+
+        auto p    = append(function, Opcode::Parameter);
+        auto ten  = append(function, Opcode::Constant, 0);
+        auto r0   = append(function, Opcode::Modulo, p, ten);
+        auto r1   = append(function, Opcode::Modulo, p, ten);
+        auto rr   = append(function, Opcode::Multiply, r0, r1);
+        auto pp   = append(function, Opcode::Multiply, p, p);
+        auto sum  = append(function, Opcode::Add, rr, pp);
+        function.result = sum;
+        module.functions.push_back(std::move(function));
+
+        inf::mir::optimize(module);
+        inf::mir::Function const &result = module.functions.front();
+        BOOST_REQUIRE(result.instructions.size() == 6u);
+
+        std::size_t modulos = 0;
+        for (Instruction const &instruction : result.instructions) {
+            if (instruction.opcode == Opcode::Modulo) {
+                ++modulos;
+                BOOST_TEST(instruction.has(Instruction::Exact64));
+                BOOST_TEST(instruction.has(Instruction::NonZeroDivisor));
+            }
+        }
+        BOOST_TEST(modulos == 1u);
+
+        Instruction const &add = result.instructions[result.result];
+        BOOST_TEST((add.opcode == Opcode::Add));
+        Instruction const &a = result.instructions[add.a];
+        Instruction const &b = result.instructions[add.b];
+        BOOST_TEST((a.opcode == Opcode::Multiply));
+        BOOST_TEST((b.opcode == Opcode::Multiply));
+        BOOST_TEST(a.has(Instruction::Exact64) != b.has(Instruction::Exact64));
+        BOOST_TEST(!add.has(Instruction::Exact64));
+    }
+
+    // a remainder always fits, but the machine faults on INT64_MIN % -1,
+    // so it is only exact when the operands rule that out.
+    {
+        inf::mir::Module   module;
+        inf::mir::Function function{};
+        function.entry      = true;
+        function.parameters = 2;
+        module.constants.emplace_back(10);
+        module.constants.emplace_back(2);
+
+        auto p     = append(function, Opcode::Parameter, 0);
+        auto q     = append(function, Opcode::Parameter, 1);
+        auto ten   = append(function, Opcode::Constant, 0);
+        auto two   = append(function, Opcode::Constant, 1);
+        auto pq    = append(function, Opcode::Modulo, p, q);
+        auto small = append(function, Opcode::Modulo, p, ten);
+        auto sq    = append(function, Opcode::Modulo, small, q);
+        auto odd   = append(function, Opcode::Modulo, q, two);
+        auto minus = append(function, Opcode::Subtract, odd, two);
+        auto pm    = append(function, Opcode::Modulo, p, minus);
+        auto pt    = append(function, Opcode::Modulo, p, two);
+        auto a     = append(function, Opcode::Add, pq, sq);
+        auto b     = append(function, Opcode::Add, pm, pt);
+        function.result = append(function, Opcode::Add, a, b);
+        module.functions.push_back(std::move(function));
+
+        inf::mir::analyze_ranges(module);
+        inf::mir::Function const &result = module.functions.front();
+        auto flags = [&](inf::mir::Value value) {
+            return result.instructions[value];
+        };
+        BOOST_TEST(!flags(pq).has(Instruction::Exact64));
+        BOOST_TEST(!flags(pq).has(Instruction::NonZeroDivisor));
+        BOOST_TEST(flags(sq).has(Instruction::Exact64));
+        // q % 2 - 2 lies in [-3, -1], which is never zero but may be -1.
+        BOOST_TEST(flags(pm).has(Instruction::NonZeroDivisor));
+        BOOST_TEST(!flags(pm).has(Instruction::Exact64));
+        BOOST_TEST(flags(pt).has(Instruction::Exact64));
+        BOOST_TEST(flags(pt).has(Instruction::NonZeroDivisor));
+    }
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_TEST_PARSE_HPP
+#define INF_TEST_PARSE_HPP
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/lower.hpp"
+#include "core/parser.hpp"
+
+// parse text as a source named after the context's module, returning the
+// parser's result; statements recovered from errors are kept.
+inline int parse(inf::Context               &context,
+                 std::string_view            text,
+                 std::vector<inf::Ast::Ptr> &statements) {
+    inf::Location source =
+        context.sources().add(context.module().getName(), text);
+    yy::Lexer lexer{&context};
+    lexer.set_view(context.sources().text(source), source);
+
+    yy::Parser parser{&lexer, &context, &statements};
+    return parser.parse();
+}
+
+inline std::vector<inf::Ast::Ptr> parse(inf::Context    &context,
+                                        std::string_view text) {
+    std::vector<inf::Ast::Ptr> statements;
+    BOOST_REQUIRE(parse(context, text, statements) == 0);
+    return statements;
+}
+
+inline inf::mir::Module lower(inf::Context               &context,
+                              std::string_view            text,
+                              std::span<inf::Label const> parameters = {}) {
+    return inf::lower(context, parse(context, text), parameters);
+}
+
+#endif // !INF_TEST_PARSE_HPP
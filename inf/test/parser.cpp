@@ -0,0 +1,67 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "boost/test/unit_test.hpp"
+
+#include "parse.hpp"
+
+BOOST_AUTO_TEST_CASE ( parser )
+{
+    // one lexical and two syntax errors are all reported, and parsing
+    // resumes after the semicolon following each of them.
+    {
+        inf::Context               context{"parser"};
+        std::vector<inf::Ast::Ptr> statements;
+        BOOST_TEST(parse(context,
+                         "a = 1; $ b = 2; c = ; d = 4; 5 +;",
+                         statements) == 0);
+        BOOST_TEST(statements.size() == 2u);
+        BOOST_TEST(context.errors().size() == 3u);
+    }
+
+    {
+        inf::Context               context{"parser"};
+        std::vector<inf::Ast::Ptr> statements;
+        BOOST_TEST(parse(context, "a = 1; a * 2;", statements) == 0);
+        BOOST_TEST(statements.size() == 2u);
+        BOOST_TEST(context.errors().empty());
+    }
+
+    // an error without a semicolon to resynchronize at ends the parse.
+    {
+        inf::Context               context{"parser"};
+        std::vector<inf::Ast::Ptr> statements;
+        BOOST_TEST(parse(context, "a = 1; b = $", statements) != 0);
+        BOOST_TEST(statements.size() == 1u);
+        BOOST_TEST(!context.errors().empty());
+    }
+
+    // every node comes from the context's ast memory, and none from the
+    // process wide default resource.
+    {
+        inf::Context               context{"parser"};
+        inf::TrackingResource      nodes;
+        std::vector<inf::Ast::Ptr> statements;
+        context.ast_memory(&nodes);
+        std::pmr::memory_resource *fallback = std::pmr::get_default_resource();
+        BOOST_TEST(parse(context, "a = 1; a * -2;", statements) == 0);
+        BOOST_TEST(nodes.stats(inf::Phase::Setup).allocations == 6u);
+        BOOST_TEST(std::pmr::get_default_resource() == fallback);
+        statements.clear();
+        BOOST_TEST(nodes.live() == 0u);
+    }
+}
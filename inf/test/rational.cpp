@@ -0,0 +1,165 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string_view>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/codegen.hpp"
+#include "core/interpret.hpp"
+#include "core/passes.hpp"
+
+#include "parse.hpp"
+
+// the single constant text folds to.
+static inf::Rational fold(std::string_view text) {
+    inf::Context     context{"rational"};
+    inf::mir::Module module = lower(context, text);
+    BOOST_REQUIRE(context.errors().empty());
+
+    inf::mir::optimize(module);
+    BOOST_REQUIRE(module.functions.size() == 1u);
+    inf::mir::Function const    &entry  = module.functions.front();
+    inf::mir::Instruction const &result = entry.instructions[entry.result];
+    BOOST_REQUIRE((result.opcode == inf::mir::Opcode::Constant));
+    return module.constants[result.a];
+}
+
+BOOST_AUTO_TEST_CASE ( rational )
+{
+    using inf::Rational;
+
+    {
+        inf::Context context{"rational"};
+        yy::Lexer    lexer{&context};
+        lexer.set_view("0.1 12.375 15e-4 2E+3 007.50 010 1e99999");
+        BOOST_TEST((lexer.advance() == Rational{1, 10}));
+        BOOST_TEST((lexer.advance() == Rational{99, 8}));
+        BOOST_TEST((lexer.advance() == Rational{3, 2000}));
+        BOOST_TEST((lexer.advance() == Rational{2000}));
+        BOOST_TEST((lexer.advance() == Rational{15, 2}));
+        BOOST_TEST((lexer.advance() == inf::Integer{10}));
+        BOOST_TEST(lexer.advance().is<yy::Lexer::Token::Error>());
+    }
+
+    // folding never rounds.
+    BOOST_TEST(fold("0.1 + 0.2 - 0.3;") == 0);
+    BOOST_TEST(fold("1 / 3 * 3;") == 1);
+    BOOST_TEST(fold("a = 1 / 3; a + a + a;") == 1);
+    BOOST_TEST(fold("7.5 % 2;") == Rational(3, 2));
+    BOOST_TEST(fold("-7 % 2;") == -1);
+    BOOST_TEST(fold("1 / 100000000000000000000 * 100000000000000000000;") == 1);
+
+    // an exact double result is returned as a double.
+    {
+        inf::Context     context{"rational"};
+        inf::mir::Module module = lower(context, "1 / 3 + 1 / 6;");
+        inf::mir::optimize(module);
+        inf::codegen(context, module);
+        BOOST_TEST(context.errors().empty());
+
+        llvm::Function *entry = context.module().getFunction("entry.0");
+        BOOST_REQUIRE(entry != nullptr);
+        BOOST_TEST(entry->getReturnType()->isDoubleTy());
+    }
+
+    // an inexact one is an error unless rounding was asked for.
+    for (bool round : {false, true}) {
+        inf::Context     context{"rational"};
+        inf::mir::Module module = lower(context, "1 / 3;");
+        inf::mir::optimize(module);
+        inf::codegen(context, module, {.round = round});
+        BOOST_TEST(context.errors().empty() == round);
+    }
+
+    // as is a quotient which is only known at runtime.
+    for (bool round : {false, true}) {
+        inf::Context       context{"rational"};
+        inf::mir::Module   module;
+        inf::mir::Function function{};
+        function.name       = context.intern_string("divide");
+        function.entry      = true;
+        function.parameters = 2;
+        auto a = function.append({inf::mir::Opcode::Parameter, 0, 0, 0}, {});
+        auto b = function.append({inf::mir::Opcode::Parameter, 0, 1, 0}, {});
+        function.result =
+            function.append({inf::mir::Opcode::Divide, 0, a, b}, {});
+        module.functions.push_back(std::move(function));
+
+        inf::mir::optimize(module);
+        inf::codegen(context, module, {.round = round});
+        BOOST_TEST(context.errors().empty() == round);
+    }
+
+    // a divisor which is always zero is reported whether or not the MIR
+    // passes ran, and whatever rounding was allowed, by codegen and the
+    // interpreter alike.
+    for (std::string_view text :
+         {"1 / 0;", "1 % 0;", "a = 0; 5 % a;", "a = 2 - 2; 7 / (a * 3);"}) {
+        for (bool mir_passes : {false, true}) {
+            for (bool round : {false, true}) {
+                for (bool interpreted : {false, true}) {
+                    inf::Context     context{"rational"};
+                    inf::mir::Module module = lower(context, text);
+                    if (mir_passes) {
+                        inf::mir::optimize(module);
+                    } else {
+                        inf::mir::fold_constants(module);
+                    }
+                    if (interpreted) {
+                        inf::assemble(context, module, round);
+                    } else {
+                        inf::codegen(context, module, {.round = round});
+                    }
+                    BOOST_REQUIRE(context.errors().size() == 1u);
+                    BOOST_TEST(context.errors()[0].message() ==
+                                   "division by zero",
+                               text);
+                }
+            }
+        }
+    }
+
+    // --no-mir skips the optional passes, but still folds constants, so it
+    // accepts the same programs.
+    for (std::string_view text : {"6 / 2;",
+                                  "1.5 * 2;",
+                                  "1 / 4;",
+                                  "a = 1 / 4; a * 4;",
+                                  "a = 7 / 2; b = a * 2; b % 4;"}) {
+        bool doubles[2] = {};
+        for (bool mir_passes : {false, true}) {
+            inf::Context     context{"rational"};
+            inf::mir::Module module = lower(context, text);
+            if (mir_passes) {
+                inf::mir::optimize(module);
+            } else {
+                inf::mir::fold_constants(module);
+            }
+            inf::codegen(context, module);
+            BOOST_TEST(context.errors().empty(), text);
+
+            for (llvm::Function const &function : context.module()) {
+                if (function.getName().starts_with("entry.")) {
+                    doubles[mir_passes] =
+                        function.getReturnType()->isDoubleTy();
+                }
+            }
+        }
+        BOOST_TEST(doubles[0] == doubles[1], text);
+    }
+}
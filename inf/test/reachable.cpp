@@ -0,0 +1,141 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <string_view>
+#include <vector>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/codegen.hpp"
+#include "core/passes.hpp"
+#include "core/reachable.hpp"
+
+#include "parse.hpp"
+
+// the labels of the bindings kept, with "" for each entry.
+static std::vector<std::string_view>
+kept(std::vector<inf::Ast::Ptr> const &statements) {
+    std::vector<std::string_view> labels;
+    for (inf::Ast::Ptr const &statement : statements) {
+        labels.push_back(statement->is<inf::Ast::Binding>()
+                             ? statement->as<inf::Ast::Binding>().label
+                             : "");
+    }
+    return labels;
+}
+
+BOOST_AUTO_TEST_CASE ( reachable )
+{
+    using Labels = std::vector<std::string_view>;
+
+    // only what the entry refers to, directly or not, is kept.
+    {
+        inf::Context context{"reachable"};
+        auto         statements =
+            parse(context, "a = 1; b = a + 1; c = 100; d = c; b * 2;");
+        inf::retain_reachable(context, statements);
+        BOOST_TEST(context.errors().empty());
+        BOOST_TEST(kept(statements) == (Labels{"a", "b", ""}));
+    }
+
+    // a reference is to the last binding before it, not the last of all.
+    {
+        inf::Context context{"reachable"};
+        auto         statements =
+            parse(context, "a = 1; b = a; a = 5; c = a; a = 9; c;");
+        inf::retain_reachable(context, statements);
+        BOOST_TEST(kept(statements) == (Labels{"a", "c", ""}));
+
+        inf::mir::Module module = inf::lower(context, statements);
+        BOOST_REQUIRE(context.errors().empty());
+        inf::mir::optimize(module);
+        BOOST_REQUIRE(module.functions.size() == 1u);
+        inf::mir::Function const &entry = module.functions.front();
+        BOOST_TEST(module.constants[entry.instructions[entry.result].a] == 5);
+    }
+
+    // exports are roots too, as the last binding of their label.
+    {
+        inf::Context context{"reachable"};
+        auto         statements =
+            parse(context, "a = 1; b = a; b = 2; c = 3; d = c; 0;");
+        std::vector<inf::Label> exports{context.intern_string("b"),
+                                        context.intern_string("d")};
+        inf::retain_reachable(context, statements, exports);
+        BOOST_TEST(context.errors().empty());
+        BOOST_TEST(kept(statements) == (Labels{"b", "c", "d", ""}));
+
+        // and survive the MIR passes, with their label as their symbol.
+        inf::mir::Module module = inf::lower(context, statements, {}, exports);
+        BOOST_REQUIRE(context.errors().empty());
+        inf::mir::optimize(module);
+        BOOST_TEST(module.functions.size() == 3u);
+        inf::codegen(context, module);
+        BOOST_REQUIRE(context.errors().empty());
+        for (char const *name : {"b", "d"}) {
+            llvm::Function *function = context.module().getFunction(name);
+            BOOST_REQUIRE(function != nullptr);
+            BOOST_TEST(function->hasExternalLinkage());
+        }
+    }
+
+    // a rebound export keeps its name; the binding it shadows gives it up.
+    {
+        inf::Context context{"reachable"};
+        auto         statements = parse(context, "a = 1; a = a + 1;");
+        std::vector<inf::Label> exports{context.intern_string("a")};
+        inf::retain_reachable(context, statements, exports);
+        BOOST_TEST(kept(statements) == (Labels{"a", "a"}));
+
+        inf::mir::Module module = inf::lower(context, statements, {}, exports);
+        inf::codegen(context, module);
+        BOOST_REQUIRE(context.errors().empty());
+        llvm::Function *function = context.module().getFunction("a");
+        BOOST_REQUIRE(function != nullptr);
+        BOOST_TEST(function->hasExternalLinkage());
+        BOOST_TEST(context.module().getFunction("a.shadowed") != nullptr);
+    }
+
+    // unknown names are reported once: here for what is dropped, and by
+    // lower for what is kept.
+    {
+        inf::Context context{"reachable"};
+        auto         statements = parse(context, "a = zz; b = 1; yy + b;");
+        inf::retain_reachable(context, statements);
+        BOOST_REQUIRE(context.errors().size() == 1u);
+        BOOST_TEST(context.errors()[0].message() == "unknown binding: zz");
+        BOOST_TEST(kept(statements) == (Labels{"b", ""}));
+
+        inf::lower(context, statements);
+        BOOST_REQUIRE(context.errors().size() == 2u);
+        BOOST_TEST(context.errors()[1].message() == "unknown binding: yy");
+    }
+
+    // as are unknown exports, by lower alone.
+    {
+        inf::Context context{"reachable"};
+        auto         statements = parse(context, "a = 1;");
+        std::vector<inf::Label> exports{context.intern_string("nope")};
+        inf::retain_reachable(context, statements, exports);
+        BOOST_TEST(context.errors().empty());
+        BOOST_TEST(statements.empty());
+
+        inf::lower(context, statements, {}, exports);
+        BOOST_REQUIRE(context.errors().size() == 1u);
+        BOOST_TEST(context.errors()[0].message() == "unknown export: nope");
+    }
+}
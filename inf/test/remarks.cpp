@@ -0,0 +1,88 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <filesystem>
+#include <sstream>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/codegen.hpp"
+#include "core/optimize.hpp"
+#include "core/remarks.hpp"
+
+#include "parse.hpp"
+
+struct Compiled {
+    std::vector<inf::Remarks::Remark> remarks;
+    std::string                       summary;
+    std::uintmax_t                    file_size;
+};
+
+// compile text at -O2 with remarks from the passes matching filter.
+static Compiled
+compile(std::string_view text, std::string_view filter, std::string format) {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / ("inf-remarks." + format);
+
+    inf::Context context{"remarks"};
+    inf::Remarks remarks{context, path.string(), filter, format};
+
+    // without the MIR passes the call survives for the inliner.
+    inf::mir::Module module = lower(context, text);
+    inf::codegen(context, module, {.debug_info = true});
+    BOOST_REQUIRE(context.errors().empty());
+    inf::optimize(context, 2);
+    remarks.finish();
+
+    Compiled           result{remarks.collected(), {}, 0};
+    std::ostringstream summary;
+    remarks.summarize(summary);
+    result.summary   = std::move(summary).str();
+    result.file_size = std::filesystem::file_size(path);
+    std::filesystem::remove(path);
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE ( remarks )
+{
+    for (std::string format : {"yaml", "bitstream"}) {
+        Compiled compiled = compile("a = 7; a * 3;", "inline", format);
+        BOOST_TEST(!compiled.remarks.empty());
+        BOOST_TEST(compiled.file_size > 0u);
+        for (inf::Remarks::Remark const &remark : compiled.remarks) {
+            BOOST_TEST(remark.pass == "inline");
+            BOOST_TEST(remark.function == "entry.1");
+            // the call is in the second statement, at a.
+            BOOST_TEST(remark.file == "remarks");
+            BOOST_TEST(remark.line == 1u);
+            BOOST_TEST(remark.column == 8u);
+        }
+        BOOST_TEST(compiled.summary.starts_with("entry.1 (remarks:1): "),
+                   compiled.summary);
+    }
+
+    // a filter which matches no pass collects nothing.
+    Compiled none = compile("a = 7; a * 3;", "^no-such-pass$", "yaml");
+    BOOST_TEST(none.remarks.empty());
+    BOOST_TEST(none.summary.empty());
+
+    inf::Context context{"remarks"};
+    BOOST_CHECK_THROW((inf::Remarks{context, "remarks.txt", "", "text"}),
+                      inf::Error);
+    BOOST_CHECK_THROW((inf::Remarks{context, "remarks.yaml", "(", "yaml"}),
+                      inf::Error);
+}
@@ -0,0 +1,49 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#include <sstream>
+
+#include "boost/test/unit_test.hpp"
+
+#include "env/source_manager.hpp"
+
+BOOST_AUTO_TEST_CASE ( source_manager )
+{
+    inf::SourceManager sources;
+    inf::Location      a = sources.add("a.inf", "1 + 2;\n3 * 4;\n");
+    inf::Location      b = sources.add("b.inf", "5;");
+
+    BOOST_TEST(sizeof(inf::Location) == 4u);
+    BOOST_TEST(a.valid());
+    BOOST_TEST((a < b));
+    BOOST_TEST(sources.file(a + 14)->name().str() == "a.inf");
+    BOOST_TEST(sources.file(b)->name().str() == "b.inf");
+    BOOST_TEST(sources.file(inf::Location{}) == nullptr);
+    BOOST_TEST(sources.text(a + 7) == "3 * 4;\n");
+
+    inf::SourceManager::Presumed three = sources.presume(a + 7);
+    BOOST_TEST(three.file.str() == "a.inf");
+    BOOST_TEST(three.line == 2u);
+    BOOST_TEST(three.column == 1u);
+
+    inf::SourceManager::Presumed five = sources.presume(b + 1);
+    BOOST_TEST(five.line == 1u);
+    BOOST_TEST(five.column == 2u);
+
+    std::ostringstream out;
+    sources.print(out, {a + 7, a + 12});
+    BOOST_TEST(out.str() == "a.inf:2.1-5");
+}
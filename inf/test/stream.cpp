@@ -0,0 +1,85 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <algorithm>
+#include <cstring>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/lexer.hpp"
+
+#include "tokens.hpp"
+
+namespace {
+// hands out text at most chunk bytes at a time, as a pipe might.
+struct Chunks {
+    std::string_view text;
+    std::size_t      chunk;
+
+    std::size_t operator()(char *data, std::size_t size) {
+        size = std::min({size, chunk, text.size()});
+        std::memcpy(data, text.data(), size);
+        text.remove_prefix(size);
+        return size;
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE ( stream )
+{
+    std::string text = generate(200);
+
+    inf::Context  expected_context{"stream"};
+    inf::Location expected_source =
+        expected_context.sources().add("stream", text);
+    yy::Lexer expected_lexer{&expected_context};
+    expected_lexer.set_view(expected_context.sources().text(expected_source),
+                            expected_source);
+    std::vector<yy::Lexer::Token> expected = drain(expected_lexer);
+    BOOST_REQUIRE(!expected_context.errors().empty());
+
+    for (std::size_t capacity : {1u, 7u, 64u, 64u * 1024u}) {
+        for (std::size_t chunk : {1u, 2u, 3u, 13u, 4096u}) {
+            inf::Context  context{"stream"};
+            inf::Location source = context.sources().open("stream");
+            BOOST_REQUIRE(source == expected_source);
+
+            yy::Lexer lexer{&context};
+            lexer.set_stream(Chunks{text, chunk}, source, capacity);
+            std::vector<yy::Lexer::Token> tokens = drain(lexer);
+
+            BOOST_TEST_CONTEXT("with capacity " << capacity << " and chunk "
+                                                << chunk) {
+                check_same(tokens, context, expected, expected_context);
+            }
+
+            // the file is closed with the size and lines of the text, and
+            // anything added afterwards follows it.
+            BOOST_TEST(context.sources().file(source)->size() == text.size());
+            for (yy::Lexer::Token const &token : tokens) {
+                auto actual = context.sources().presume(token.range.begin);
+                auto wanted =
+                    expected_context.sources().presume(token.range.begin);
+                BOOST_TEST(actual.line == wanted.line);
+                BOOST_TEST(actual.column == wanted.column);
+            }
+            inf::Location next = context.sources().add("next", "");
+            BOOST_TEST((next == source + static_cast<std::uint32_t>(
+                                             text.size() + 1)));
+        }
+    }
+}
@@ -0,0 +1,130 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "boost/test/unit_test.hpp"
+
+#include "env/context.hpp"
+#include "imr/symbol.hpp"
+
+static inf::Symbol binding(std::uint32_t index) {
+    return {inf::Symbol::Kind::Binding, index};
+}
+
+BOOST_AUTO_TEST_CASE ( symbol )
+{
+    inf::Context context{"symbol"};
+    inf::Label   a = context.intern_string("a");
+    inf::Label   b = context.intern_string("b");
+
+    {
+        inf::SymbolTable symbols;
+        BOOST_TEST(!symbols.find(a));
+        BOOST_TEST(symbols.bind(a, binding(1)));
+        BOOST_TEST(!symbols.bind(a, binding(2)));
+        BOOST_TEST(symbols.find(a)->index == 2u);
+
+        symbols.push();
+        BOOST_TEST(symbols.bind(a, binding(3)));
+        BOOST_TEST(symbols.bind(b, {inf::Symbol::Kind::Parameter, 4}));
+        BOOST_TEST((symbols.find(b)->kind == inf::Symbol::Kind::Parameter));
+        BOOST_TEST(symbols.find(a)->index == 3u);
+        BOOST_TEST(symbols.size() == 2u);
+        symbols.pop();
+
+        BOOST_TEST(symbols.find(a)->index == 2u);
+        BOOST_TEST(!symbols.find(b));
+        BOOST_TEST(symbols.size() == 1u);
+        BOOST_TEST(symbols.depth() == 0u);
+    }
+
+    // random binds, lookups and scopes, checked against a map of stacks,
+    // with enough labels to grow the table and collide often.
+    {
+        std::vector<inf::Label> labels;
+        for (unsigned index = 0; index < 2000; ++index) {
+            labels.push_back(
+                context.intern_string("x" + std::to_string(index)));
+        }
+
+        struct Bound {
+            std::uint32_t index;
+            std::size_t   depth;
+        };
+        std::map<char const *, std::vector<Bound>> model;
+        std::vector<std::vector<char const *>>     scopes(1);
+
+        inf::SymbolTable symbols;
+        std::mt19937     random{37};
+        for (std::uint32_t step = 0; step < 200000; ++step) {
+            inf::Label label = labels[random() % labels.size()];
+            switch (random() % 8) {
+            case 0:
+                symbols.push();
+                scopes.emplace_back();
+                break;
+
+            case 1:
+                if (scopes.size() == 1) { break; }
+                symbols.pop();
+                for (char const *key : scopes.back()) {
+                    model[key].pop_back();
+                }
+                scopes.pop_back();
+                break;
+
+            case 2:
+            case 3:
+            case 4: {
+                std::vector<Bound> &stack = model[label.data()];
+                bool                fresh =
+                    stack.empty() || stack.back().depth != scopes.size();
+                BOOST_REQUIRE(symbols.bind(label, binding(step)) == fresh);
+                if (fresh) {
+                    stack.push_back({step, scopes.size()});
+                    scopes.back().push_back(label.data());
+                } else {
+                    stack.back().index = step;
+                }
+                break;
+            }
+
+            default: {
+                std::vector<Bound>        &stack  = model[label.data()];
+                std::optional<inf::Symbol> symbol = symbols.find(label);
+                if (stack.empty()) {
+                    BOOST_REQUIRE(!symbol);
+                } else {
+                    BOOST_REQUIRE(symbol.has_value());
+                    BOOST_REQUIRE(symbol->index == stack.back().index);
+                }
+                break;
+            }
+            }
+        }
+
+        while (symbols.depth() != 0) {
+            symbols.pop();
+        }
+        BOOST_TEST(symbols.size() == scopes.front().size());
+    }
+}
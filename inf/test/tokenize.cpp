@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/tokenize.hpp"
+
+#include "tokens.hpp"
+
+BOOST_AUTO_TEST_CASE ( tokenize )
+{
+    std::string text = generate(50000);
+
+    inf::Context  expected_context{"tokenize"};
+    inf::Location expected_source =
+        expected_context.sources().add("tokenize", text);
+    yy::Lexer expected_lexer{&expected_context};
+    expected_lexer.set_view(expected_context.sources().text(expected_source),
+                            expected_source);
+    std::vector<yy::Lexer::Token> expected = drain(expected_lexer);
+    BOOST_REQUIRE(!expected_context.errors().empty());
+
+    for (unsigned threads : {1u, 2u, 3u, 8u, 32u}) {
+        inf::Context  context{"tokenize"};
+        inf::Location source = context.sources().add("tokenize", text);
+        BOOST_REQUIRE(source == expected_source);
+
+        std::vector<yy::Lexer::Token> tokens =
+            inf::tokenize(context, source, threads);
+        BOOST_TEST_CONTEXT("with " << threads << " threads") {
+            check_same(tokens, context, expected, expected_context);
+        }
+    }
+}
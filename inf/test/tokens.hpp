@@ -0,0 +1,80 @@
+// Copyright (C) 2024 Cade Weinberg
+//
+// This file is part of inf.
+//
+// inf is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// inf is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with inf.  If not, see <http://www.gnu.org/licenses/>.
+#ifndef INF_TEST_TOKENS_HPP
+#define INF_TEST_TOKENS_HPP
+
+#include <string>
+#include <vector>
+
+#include "boost/test/unit_test.hpp"
+
+#include "core/lexer.hpp"
+#include "env/context.hpp"
+
+// statements with tokens longer than the smaller lexer buffers, a lexical
+// error every few lines, and blank lines after each error.
+inline std::string generate(unsigned statements) {
+    std::string text = "a = 12.375 * 15e-4;\n";
+    text += std::string(300, 'x') + " = " + std::string(200, '7') + ";\n";
+    for (unsigned index = 0; index < statements; ++index) {
+        std::string name = "v" + std::to_string(index);
+        text += name + " = (" + std::to_string(index) + " + 1e3) * 1.5 % (" +
+                name + " + 7);";
+        text += index % 17 == 0 ? " $\n\n" : "\n";
+    }
+    return text + "a * 2.5";
+}
+
+inline std::vector<yy::Lexer::Token> drain(yy::Lexer &lexer) {
+    std::vector<yy::Lexer::Token> tokens;
+    do {
+        tokens.emplace_back(lexer.advance());
+    } while (!tokens.back().is<yy::Lexer::Token::End>());
+    return tokens;
+}
+
+inline bool same(yy::Lexer::Token const &a, yy::Lexer::Token const &b) {
+    if (!(a.range == b.range)) { return false; }
+    if (a.is<yy::Lexer::Token::Error>()) {
+        return b.is<yy::Lexer::Token::Error>() &&
+               a.as<yy::Lexer::Token::Error>().index ==
+                   b.as<yy::Lexer::Token::Error>().index;
+    }
+    return a == b;
+}
+
+// the tokens and errors of context match those of the expected context.
+inline void check_same(std::vector<yy::Lexer::Token> const &tokens,
+                       inf::Context const &context,
+                       std::vector<yy::Lexer::Token> const &expected,
+                       inf::Context const &expected_context) {
+    BOOST_REQUIRE(tokens.size() == expected.size());
+    for (std::size_t index = 0; index < tokens.size(); ++index) {
+        BOOST_TEST(same(tokens[index], expected[index]), "token " << index);
+    }
+
+    inf::ErrorList const &errors = context.errors();
+    BOOST_REQUIRE(errors.size() == expected_context.errors().size());
+    for (std::size_t index = 0; index < errors.size(); ++index) {
+        BOOST_TEST(errors[index].message() ==
+                   expected_context.errors()[index].message());
+        BOOST_TEST((errors[index].range() ==
+                    expected_context.errors()[index].range()));
+    }
+}
+
+#endif // !INF_TEST_TOKENS_HPP